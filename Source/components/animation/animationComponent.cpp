@@ -68,7 +68,8 @@ IMPLEMENT_CALLBACK(AnimationComponent, onAnimationTrigger, void, (Component* obj
 //////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
-AnimationComponent::AnimationComponent() : Component()
+AnimationComponent::AnimationComponent() : Component(),
+   mOwnerShapeComponent(this)
 {
    mNetworked = true;
 
@@ -77,8 +78,6 @@ AnimationComponent::AnimationComponent() : Component()
 
    mDescription = getDescriptionText("Allows a rendered mesh to be animated");
 
-   mOwnerShapeComponent = NULL;
-
    mOwnerShapeInstance = NULL;
 
    for (U32 i = 0; i < MaxScriptThreads; i++)
@@ -141,18 +140,15 @@ bool AnimationComponent::onAdd()
 void AnimationComponent::onRemove()
 {
    Parent::onRemove();
-
-   mOwnerShapeComponent = NULL;
 }
 
 void AnimationComponent::onComponentAdd()
 {
    //test if this is a shape component!
-   MeshComponent* shapeComponent = mOwner->getComponent<MeshComponent>(StringTable->insert("renderComponent"));
-   if (shapeComponent)
+   if (mOwnerShapeComponent)
    {
-      shapeComponent->onShapeInstanceChanged.notify(this, &AnimationComponent::targetShapeChanged);
-      targetShapeChanged(shapeComponent);
+      mOwnerShapeComponent->onShapeInstanceChanged.notify(this, &AnimationComponent::targetShapeChanged);
+      targetShapeChanged(mOwnerShapeComponent);
    }
 }
 
@@ -162,8 +158,8 @@ void AnimationComponent::componentAddedToOwner(Component *comp)
       return;
 
    //test if this is a shape component!
-   MeshComponent* shapeComponent = mOwner->getComponent<MeshComponent>(StringTable->insert("renderComponent"));
-   if (shapeComponent)
+   MeshComponent* shapeComponent = dynamic_cast<MeshComponent*>(comp);
+   if (shapeComponent && shapeComponent == mOwnerShapeComponent)
    {
       shapeComponent->onShapeInstanceChanged.notify(this, &AnimationComponent::targetShapeChanged);
       targetShapeChanged(shapeComponent);
@@ -180,20 +176,19 @@ void AnimationComponent::componentRemovedFromOwner(Component *comp)
    if (shapeComponent)
    {
       shapeComponent->onShapeInstanceChanged.remove(this, &AnimationComponent::targetShapeChanged);
-      mOwnerShapeComponent = NULL;
+
+      if (!mOwnerShapeComponent)
+         mOwnerShapeInstance = NULL;
    }
 }
 
 void AnimationComponent::targetShapeChanged(MeshComponent* shapeComponent)
 {
-   mOwnerShapeComponent = shapeComponent;
-
-   if (!mOwnerShapeComponent || !getShape())
+   //we only animate the shape our ref is bound to
+   if (!shapeComponent || shapeComponent != mOwnerShapeComponent || !getShape())
       return;
 
-   MeshComponent* meshComp = dynamic_cast<MeshComponent*>(mOwnerShapeComponent);
-
-   mOwnerShapeInstance = meshComp->getShapeInstance();
+   mOwnerShapeInstance = shapeComponent->getShapeInstance();
 
    if (!mOwnerShapeInstance)
       return;
@@ -270,6 +265,18 @@ void AnimationComponent::processTick()
    }
 }
 
+bool AnimationComponent::isIdle()
+{
+   for (U32 i = 0; i < MaxScriptThreads; i++)
+   {
+      const Thread& st = mAnimationThreads[i];
+      if (st.thread && st.sequence != -1 && st.state == Thread::Play && !st.atEnd)
+         return false;
+   }
+
+   return true;
+}
+
 void AnimationComponent::advanceTime(F32 dt)
 {
    Parent::advanceTime(dt);
@@ -281,8 +288,12 @@ void AnimationComponent::advanceTime(F32 dt)
 //
 const char *AnimationComponent::getThreadSequenceName(U32 slot)
 {
-   Thread& st = mAnimationThreads[slot];
-   if (st.sequence == -1)
+   return getSequenceName(mAnimationThreads[slot].sequence);
+}
+
+const char *AnimationComponent::getSequenceName(S32 sequence)
+{
+   if (sequence == -1)
    {
       // Invalid Animation.
       return "";
@@ -291,9 +302,9 @@ const char *AnimationComponent::getThreadSequenceName(U32 slot)
    // Name Index
    TSShape* shape = getShape();
 
-   if (shape)
+   if (shape && sequence < shape->sequences.size())
    {
-      const U32 nameIndex = shape->sequences[st.sequence].nameIndex;
+      const U32 nameIndex = shape->sequences[sequence].nameIndex;
 
       // Return Name.
       return shape->getName(nameIndex);
@@ -423,6 +434,8 @@ void AnimationComponent::updateThread(Thread& st)
          }
       } break;
    }
+
+   mOwnerShapeComponent->markPoseDirty();
 }
 
 bool AnimationComponent::stopThread(U32 slot)
@@ -623,7 +636,14 @@ void AnimationComponent::advanceThreads(F32 dt)
 
             if (!isClientObject())
             {
-               Con::executef(this, "onAnimationEnd", st.thread->getSequenceName());
+               //we may be ticking on a worker thread, so script gets told once we're back on the main thread.
+               //The name is only looked up there too, as copying a String out of a shape other entities
+               //share would bump its refcount from several threads at once
+               const S32 sequence = st.sequence;
+               ComponentTickScheduler::deferCall(this, [sequence](SimObject* obj) {
+                  AnimationComponent* animComp = static_cast<AnimationComponent*>(obj);
+                  Con::executef(animComp, "onAnimationEnd", animComp->getSequenceName(sequence));
+               });
             }
          }
 
@@ -632,6 +652,7 @@ void AnimationComponent::advanceThreads(F32 dt)
          if (st.thread)
          {
             mOwnerShapeInstance->advanceTime(dt, st.thread);
+            mOwnerShapeComponent->markPoseDirty();
          }
 
          if (mOwnerShapeInstance && !isClientObject())
@@ -640,24 +661,28 @@ void AnimationComponent::advanceThreads(F32 dt)
             {
                if (mOwnerShapeInstance->getTriggerState(stateIDx))
                {
-                  const char* animName = st.thread->getSequenceName().c_str();
-                  onAnimationTrigger_callback(this, animName, stateIDx);
+                  const S32 sequence = st.sequence;
+                  ComponentTickScheduler::deferCall(this, [sequence, stateIDx](SimObject* obj) {
+                     AnimationComponent* animComp = static_cast<AnimationComponent*>(obj);
+                     animComp->onAnimationTrigger_callback(animComp, animComp->getSequenceName(sequence), stateIDx);
+                  });
                }
             }
          }
-
-         if (isClientObject())
-         {
-            mOwnerShapeInstance->animate();
-            /*mOwnerShapeInstance->animateGround();
-            MatrixF groundTransform = mOwnerShapeInstance->getGroundTransform();
-            if (groundTransform != MatrixF::Identity)
-            {
-               mOwner->setPosition(groundTransform.getPosition());
-            }*/
-         }
       }
    }
+
+   //Once for all the threads, rather than after each one
+   if (isClientObject())
+   {
+      mOwnerShapeComponent->updateNodeTransforms();
+      /*mOwnerShapeInstance->animateGround();
+      MatrixF groundTransform = mOwnerShapeInstance->getGroundTransform();
+      if (groundTransform != MatrixF::Identity)
+      {
+         mOwner->setPosition(groundTransform.getPosition());
+      }*/
+   }
 }
 
 TSShape* AnimationComponent::getShape()
@@ -665,7 +690,7 @@ TSShape* AnimationComponent::getShape()
    if (mOwner == NULL)
       return NULL;
 
-   if (mOwnerShapeComponent == NULL)
+   if (!mOwnerShapeComponent)
       return NULL;
 
    return mOwnerShapeComponent->getShape();
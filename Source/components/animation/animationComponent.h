@@ -77,7 +77,7 @@ protected:
    Thread mAnimationThreads[MaxScriptThreads];
 
 protected:
-   MeshComponent* mOwnerShapeComponent;
+   ComponentRef<MeshComponent> mOwnerShapeComponent;
 
    TSShapeInstance *mOwnerShapeInstance;
 
@@ -85,6 +85,7 @@ public:
    AnimationComponent();
    virtual ~AnimationComponent();
    DECLARE_CONOBJECT(AnimationComponent);
+   DECLARE_COMPONENT_TYPE(AnimationComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -98,14 +99,22 @@ public:
    virtual U32 packUpdate(NetConnection *con, U32 mask, BitStream *stream);
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
 
+   //Thread changes are cosmetic, so they can wait behind anything else the owner has to send
+   virtual F32 getNetUpdatePriority(NetConnection *con, F32 ownerPriority) { return ownerPriority * 0.5f; }
+
    TSShape* getShape();
 
    virtual void targetShapeChanged(MeshComponent* shapeComponent);
 
    virtual void processTick();
+   virtual U32 getTickPhase() const { return ComponentTickScheduler::AnimationPhase; }
+   //Thread advancing only touches our own shape instance, and script callbacks are deferred
+   virtual bool isTickThreadSafe() const { return true; }
+   virtual bool isIdle();
    virtual void advanceTime(F32 dt);
 
    const char *getThreadSequenceName(U32 slot);
+   const char *getSequenceName(S32 sequence);
    bool setThreadSequence(U32 slot, S32 seq, bool reset = true, bool transition = true, F32 transitionTime = 0.5);
    void updateThread(Thread& st);
    bool stopThread(U32 slot);
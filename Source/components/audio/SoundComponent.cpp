@@ -243,24 +243,6 @@ void SoundComponent::onEndInspect()
 {
 }
 
-//Process tick update function, natch
-void SoundComponent::processTick()
-{
-   Parent::processTick();
-}
-
-//Client-side advance function
-void SoundComponent::advanceTime(F32 dt)
-{
-
-}
-
-//Client-side interpolation function
-void SoundComponent::interpolateTick(F32 delta)
-{
-
-}
-
 void SoundComponent::prepRenderImage(SceneRenderState *state)
 {
    if (!mEnabled || !mOwner || !gEditingMission)
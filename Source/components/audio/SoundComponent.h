@@ -84,6 +84,7 @@ public:
    SoundComponent();
    virtual ~SoundComponent();
    DECLARE_CONOBJECT(SoundComponent);
+   DECLARE_COMPONENT_TYPE(SoundComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -103,10 +104,6 @@ public:
    virtual void onInspect();
    virtual void onEndInspect();
 
-   virtual void processTick();
-   virtual void advanceTime(F32 dt);
-   virtual void interpolateTick(F32 delta);
-
    void prepRenderImage(SceneRenderState* state);
    void _renderObject(ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat);
 
@@ -87,6 +87,7 @@ public:
    Behavior();
    virtual ~Behavior();
    DECLARE_CONOBJECT(Behavior);
+   DECLARE_COMPONENT_TYPE(Behavior, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -99,9 +100,6 @@ public:
    //This is called when we are removed from an entity
    virtual void onComponentRemove();         
 
-   //Overridden by components that actually care
-   virtual void ownerTransformSet(MatrixF *mat) {}
-
    bool	isEnabled() { return mEnabled; }
    void  setEnabled(bool toggle) { mEnabled = toggle; setMaskBits(EnableMask); }
 
@@ -110,8 +108,6 @@ public:
    static bool _setEnabled(void *object, const char *index, const char *data);
 
    virtual void processTick();
-   virtual void interpolateTick(F32 dt){}
-   virtual void advanceTime(F32 dt){}
 
    /// @name Adding Named Fields
    /// @{
@@ -63,7 +63,8 @@ IMPLEMENT_CALLBACK( CameraComponent, validateCameraFov, F32, (F32 fov), (fov),
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
 
-CameraComponent::CameraComponent() : Component()
+CameraComponent::CameraComponent() : Component(),
+   mOwnerRenderComp(this)
 {
    mClientScreen = Point2F(1, 1);
 
@@ -251,7 +252,7 @@ bool CameraComponent::getCameraTransform(F32* pos,MatrixF* mat)
    }
    else
    {
-      renderComponent* renderComp = mOwner->getComponent<renderComponent>(StringTable->insert("renderComponent"));
+      renderComponent* renderComp = mOwnerRenderComp;
 
       if (!renderComp)
          return false;
@@ -342,7 +343,7 @@ U32 CameraComponent::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
 
    if (stream->writeFlag(mask & OffsetMask))
    {
-      renderComponent* renderComp = getOwner()->getComponent<renderComponent>(StringTable->insert("renderComponent"));
+      renderComponent* renderComp = mOwnerRenderComp;
 
       if (renderComp && renderComp->getShape())
       {
@@ -38,6 +38,7 @@
 
 class SceneRenderState;
 struct CameraScopeQuery;
+class renderComponent;
 
 //////////////////////////////////////////////////////////////////////////
 /// 
@@ -64,6 +65,8 @@ protected:
 
    bool mUseParentTransform;
 
+   ComponentRef<renderComponent> mOwnerRenderComp;
+
    enum
    {
       FOVMask = Parent::NextFreeMask,
@@ -75,6 +78,7 @@ public:
    CameraComponent();
    virtual ~CameraComponent();
    DECLARE_CONOBJECT(CameraComponent);
+   DECLARE_COMPONENT_TYPE(CameraComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -80,7 +80,7 @@ void CameraOrbiterComponent::onComponentAdd()
 {
    Parent::onComponentAdd();
 
-   CameraComponent *cam = mOwner->getComponent<CameraComponent>(StringTable->insert("cameraComponent"));
+   CameraComponent *cam = mOwner->getComponent<CameraComponent>();
    if (cam)
    {
       mCamera = cam;
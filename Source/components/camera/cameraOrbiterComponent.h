@@ -54,6 +54,7 @@ public:
    CameraOrbiterComponent();
    virtual ~CameraOrbiterComponent();
    DECLARE_CONOBJECT(CameraOrbiterComponent);
+   DECLARE_COMPONENT_TYPE(CameraOrbiterComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -69,6 +70,7 @@ public:
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
 
    virtual void processTick();
+   virtual U32 getTickPhase() const { return ComponentTickScheduler::CameraPhase; }
 };
 
 #endif // EXAMPLEBEHAVIOR_H
@@ -113,11 +113,9 @@ void CollisionComponent::handleCollisionList( CollisionList &collisionList, Vect
             Entity* ent = dynamic_cast<Entity*>(colCheck.object);
             if (ent)
             {
-               Component* foundComp = ent->getComponent(mComponentType);
-               if (foundComp != nullptr)
+               CollisionComponent* colObject = ent->getComponent<CollisionComponent>();
+               if (colObject != nullptr)
                {
-                  CollisionComponent* colObject = static_cast<CollisionComponent*>(foundComp);
-
                   //convert us to our component
                   Component* thisComp = dynamic_cast<Component*>(this);
                   if (thisComp)
@@ -143,6 +141,9 @@ void CollisionComponent::handleCollisionList( CollisionList &collisionList, Vect
 
 void CollisionComponent::handleCollision( Collision &col, VectorF velocity )
 {
+   if (mOwner)
+      mOwner->wakeUp();
+
    if (col.object && (mContactInfo.contactObject == NULL ||
       col.object->getId() != mContactInfo.contactObject->getId()))
    {
@@ -156,7 +157,7 @@ void CollisionComponent::handleCollision( Collision &col, VectorF velocity )
          Con::executef(comp, "onCollision", col.object, col.normal, col.point, matId, velocity);
       }
 
-      if (comp->getOwner()->isMethod("onCollisionEvent"))
+      if (comp->getOwner()->hasScriptCallback(Entity::CollisionEventCallback))
       {
          S32 matId = col.material != NULL ? col.material->getMaterial()->getId() : 0;
          Con::executef(comp->getOwner(), "onCollisionEvent", col.object, col.normal, col.point, matId, velocity);
@@ -135,6 +135,8 @@ public:
    virtual ~CollisionComponent();
 
    DECLARE_CONOBJECT(CollisionComponent);
+   DECLARE_COMPONENT_TYPE(CollisionComponent, Component);
+   virtual U32 getTickPhase() const { return ComponentTickScheduler::CollisionPhase; }
 
    //Setup
    virtual void prepCollision() {};
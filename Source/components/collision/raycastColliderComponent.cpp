@@ -5,7 +5,7 @@ IMPLEMENT_CO_DATABLOCK_V1(RaycastColliderComponent);
 
 RaycastColliderComponent::RaycastColliderComponent() :
    mUseVelocity(false),
-   mOwnerPhysicsComponent(nullptr),
+   mOwnerPhysicsComponent(this),
    mRayDirection(VectorF::Zero),
    mRayLength(1),
    mPhysicsWorld(nullptr),
@@ -39,42 +39,6 @@ void RaycastColliderComponent::initPersistFields()
    Parent::initPersistFields();
 }
 
-void RaycastColliderComponent::onComponentAdd()
-{
-   PhysicsComponent* physComp = mOwner->getComponent<PhysicsComponent>(StringTable->insert("physicsComponent"));
-
-   if (physComp)
-   {
-      mOwnerPhysicsComponent = physComp;
-   }
-}
-
-void RaycastColliderComponent::onComponentRemove()
-{
-   mOwnerPhysicsComponent = nullptr;
-}
-
-void RaycastColliderComponent::componentAddedToOwner(Component *comp) 
-{
-   Parent::componentAddedToOwner(comp);
-
-   PhysicsComponent* physComp = dynamic_cast<PhysicsComponent*>(comp);
-   if (physComp)
-   {
-      mOwnerPhysicsComponent = physComp;
-   }
-}
-
-void RaycastColliderComponent::componentRemovedFromOwner(Component *comp)
-{
-   Parent::componentRemovedFromOwner(comp);
-
-   if (mOwnerPhysicsComponent != nullptr && mOwnerPhysicsComponent->getId() == comp->getId())
-   {
-      mOwnerPhysicsComponent = nullptr;
-   }
-}
-
 void RaycastColliderComponent::processTick() 
 {
    Parent::processTick();
@@ -110,13 +74,3 @@ void RaycastColliderComponent::processTick()
    if (mUseVelocity)
       mOldPosition = end;
 }
-
-void RaycastColliderComponent::interpolateTick(F32 dt) 
-{
-   Parent::interpolateTick(dt);
-}
-
-void RaycastColliderComponent::advanceTime(F32 dt) 
-{
-   Parent::advanceTime(dt);
-}
@@ -8,7 +8,7 @@ class RaycastColliderComponent : public CollisionComponent
 
    //If we're velocity based, we need a physics component on our owner to calculate the vel
    bool mUseVelocity;
-   PhysicsComponent* mOwnerPhysicsComponent;
+   ComponentRef<PhysicsComponent> mOwnerPhysicsComponent;
 
    //If we're not using velocity, we'll just have a set direction and length we check against
    VectorF mRayDirection;
@@ -22,6 +22,7 @@ class RaycastColliderComponent : public CollisionComponent
 
 public:
    DECLARE_CONOBJECT(RaycastColliderComponent);
+   DECLARE_COMPONENT_TYPE(RaycastColliderComponent, CollisionComponent);
 
    RaycastColliderComponent();
    ~RaycastColliderComponent();
@@ -30,15 +31,5 @@ public:
    virtual void onRemove();
    static void initPersistFields();
 
-   virtual void onComponentAdd();
-   virtual void onComponentRemove();
-
-   //This is called when a different component is added to our owner entity
-   virtual void componentAddedToOwner(Component *comp);
-   //This is called when a different component is removed from our owner entity
-   virtual void componentRemovedFromOwner(Component *comp);
-
    virtual void processTick();
-   virtual void interpolateTick(F32 dt);
-   virtual void advanceTime(F32 dt);
 };
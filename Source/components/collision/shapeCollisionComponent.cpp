@@ -122,7 +122,9 @@ ImplementEnumType(CollisionMeshMeshType,
 EndImplementEnumType;
 
 //
-ShapeCollisionComponent::ShapeCollisionComponent() : CollisionComponent()
+ShapeCollisionComponent::ShapeCollisionComponent() : CollisionComponent(),
+   mOwnerShapeComponent(this),
+   mOwnerPhysicsComp(this)
 {
    mFriendlyName = "Shape Collision Component";
 
@@ -130,8 +132,6 @@ ShapeCollisionComponent::ShapeCollisionComponent() : CollisionComponent()
 
    mDescription = getDescriptionText("A stub component class that physics components should inherit from.");
 
-   mOwnerShapeComponent = NULL;
-   mOwnerPhysicsComp = NULL;
 
    mBlockColliding = true;
 
@@ -161,20 +161,11 @@ void ShapeCollisionComponent::onComponentAdd()
 {
    Parent::onComponentAdd();
 
-   MeshComponent* meshComponent = mOwner->getComponent<MeshComponent>(StringTable->insert("renderComponent"));
-   if (meshComponent)
-   {
-      meshComponent->onShapeInstanceChanged.notify(this, &ShapeCollisionComponent::targetShapeChanged);
-      mOwnerShapeComponent = meshComponent;
-   }
+   if (mOwnerShapeComponent)
+      mOwnerShapeComponent->onShapeInstanceChanged.notify(this, &ShapeCollisionComponent::targetShapeChanged);
 
    //physicsInterface
-   PhysicsComponent *physicsComp = mOwner->getComponent<PhysicsComponent>(StringTable->insert("physicsComponent"));
-   if (physicsComp)
-   {
-      mOwnerPhysicsComp = physicsComp;
-   }
-   else
+   if (!mOwnerPhysicsComp)
    {
       if (PHYSICSMGR)
       {
@@ -189,8 +180,6 @@ void ShapeCollisionComponent::onComponentRemove()
 {
    SAFE_DELETE(mPhysicsRep);
 
-   mOwnerPhysicsComp = nullptr;
-
    mCollisionInited = false;
 
    Parent::onComponentRemove();
@@ -206,7 +195,6 @@ void ShapeCollisionComponent::componentAddedToOwner(Component *comp)
    if (meshComponent)
    {
       meshComponent->onShapeInstanceChanged.notify(this, &ShapeCollisionComponent::targetShapeChanged);
-      mOwnerShapeComponent = meshComponent;
       prepCollision();
    }
 
@@ -216,8 +204,6 @@ void ShapeCollisionComponent::componentAddedToOwner(Component *comp)
       if (mPhysicsRep)
          SAFE_DELETE(mPhysicsRep);
 
-      mOwnerPhysicsComp = physicsComp;
-
       prepCollision();
    }
 }
@@ -232,7 +218,6 @@ void ShapeCollisionComponent::componentRemovedFromOwner(Component *comp)
    if (meshComponent)
    {
       meshComponent->onShapeInstanceChanged.remove(this, &ShapeCollisionComponent::targetShapeChanged);
-      mOwnerShapeComponent = NULL;
       prepCollision();
    }
 
@@ -244,8 +229,6 @@ void ShapeCollisionComponent::componentRemovedFromOwner(Component *comp)
 
       mCollisionInited = false;
 
-      mOwnerPhysicsComp = nullptr;
-
       prepCollision();
    }
 }
@@ -327,13 +310,6 @@ void ShapeCollisionComponent::unpackUpdate(NetConnection *con, BitStream *stream
    }
 }
 
-void ShapeCollisionComponent::ownerTransformSet(MatrixF *mat)
-{
-   /*bool isSrv = isServerObject();
-   if (mPhysicsRep && mCollisionInited)
-      mPhysicsRep->setTransform(mOwner->getTransform());*/
-}
-
 //Setup
 void ShapeCollisionComponent::targetShapeChanged(MeshComponent* shapeComponent)
 {
@@ -417,6 +393,12 @@ void ShapeCollisionComponent::processTick()
       mContactInfo.clear();
 }
 
+bool ShapeCollisionComponent::isIdle()
+{
+   //Nothing to call back about. Anything that runs into us wakes our owner through handleCollision
+   return mContactInfo.contactObject == NULL && mContactInfo.contactTimer == 0;
+}
+
 void ShapeCollisionComponent::updatePhysics()
 {
    
@@ -424,7 +406,7 @@ void ShapeCollisionComponent::updatePhysics()
 
 PhysicsCollision* ShapeCollisionComponent::getCollisionData()
 {
-   if ((!PHYSICSMGR || mCollisionType == None) || mOwnerShapeComponent == NULL)
+   if ((!PHYSICSMGR || mCollisionType == None) || !mOwnerShapeComponent)
       return NULL;
 
    PhysicsCollision *colShape = NULL;
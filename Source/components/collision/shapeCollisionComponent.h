@@ -72,9 +72,9 @@ protected:
 
    StringTableEntry colisionMeshPrefix;
 
-   MeshComponent* mOwnerShapeComponent;
+   ComponentRef<MeshComponent> mOwnerShapeComponent;
 
-   PhysicsComponent* mOwnerPhysicsComp;
+   ComponentRef<PhysicsComponent> mOwnerPhysicsComp;
 
    //only really relevent for the collision mesh type
    //if we note an animation component is added, we flag as being animated.
@@ -91,13 +91,13 @@ public:
    ShapeCollisionComponent();
    virtual ~ShapeCollisionComponent();
    DECLARE_CONOBJECT(ShapeCollisionComponent);
+   DECLARE_COMPONENT_TYPE(ShapeCollisionComponent, CollisionComponent);
 
    virtual U32 packUpdate(NetConnection *con, U32 mask, BitStream *stream);
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
 
    virtual void componentAddedToOwner(Component *comp);
    virtual void componentRemovedFromOwner(Component *comp);
-   virtual void ownerTransformSet(MatrixF *mat);
    void targetShapeChanged(MeshComponent* shapeComponent);
 
    virtual void onComponentRemove();
@@ -114,6 +114,7 @@ public:
 
    //Updates
    virtual void processTick();
+   virtual bool isIdle();
    
    PhysicsCollision* buildColShapes();
 
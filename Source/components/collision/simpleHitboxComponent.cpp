@@ -49,21 +49,6 @@ void SimpleHitboxComponent::componentRemovedFromOwner(Component *comp)
    Parent::componentRemovedFromOwner(comp);
 }
 
-void SimpleHitboxComponent::processTick()
-{
-   Parent::processTick();
-}
-
-void SimpleHitboxComponent::interpolateTick(F32 dt)
-{
-   Parent::interpolateTick(dt);
-}
-
-void SimpleHitboxComponent::advanceTime(F32 dt)
-{
-   Parent::advanceTime(dt);
-}
-
 void SimpleHitboxComponent::getDamageLocation(const Point3F& in_rPos, const char *&out_rpVert, const char *&out_rpQuad)
 {
    Point3F newPoint;
@@ -29,11 +29,8 @@ public:
    virtual void componentAddedToOwner(Component *comp);
    virtual void componentRemovedFromOwner(Component *comp);
 
-   virtual void processTick();
-   virtual void interpolateTick(F32 dt);
-   virtual void advanceTime(F32 dt);
-
    void getDamageLocation(const Point3F& in_rPos, const char *&out_rpVert, const char *&out_rpQuad);
 
    DECLARE_CONOBJECT(SimpleHitboxComponent);
+   DECLARE_COMPONENT_TYPE(SimpleHitboxComponent, Component);
 };
@@ -69,6 +69,13 @@ Component::Component()
    mEnabled = true;
 
    mDirtyMaskBits = 0;
+
+   mTickIndex = -1;
+
+   mNetSlot = -1;
+
+   mComponentRefs = NULL;
+   mComponentRefMask = 0;
 }
 
 Component::~Component()
@@ -207,6 +214,8 @@ void Component::setOwner(Entity* owner)
       mOwner->onComponentRemoved.notify(this, &Component::componentRemovedFromOwner);
    }
 
+   rebindComponentRefs(mComponentRefMask);
+
    if (isServerObject())
    {
       setMaskBits(OwnerMask);
@@ -219,6 +228,35 @@ void Component::setOwner(Entity* owner)
    }
 }
 
+ComponentRefBase::ComponentRefBase(Component* holder, U32 typeId)
+{
+   mComponent = NULL;
+   mTypeId = typeId;
+
+   mNext = holder->mComponentRefs;
+   holder->mComponentRefs = this;
+   holder->mComponentRefMask |= ComponentTypeRegistry::getTypeBit(typeId);
+}
+
+void Component::rebindComponentRefs(ComponentTypeMask changedTypes)
+{
+   if (!(mComponentRefMask & changedTypes))
+      return;
+
+   for (ComponentRefBase* ref = mComponentRefs; ref != NULL; ref = ref->mNext)
+   {
+      const ComponentTypeMask typeBit = ComponentTypeRegistry::getTypeBit(ref->mTypeId);
+      if (!(changedTypes & typeBit))
+         continue;
+
+      Component* sibling = NULL;
+      if (mOwner && (mOwner->mComponentTypeMask & typeBit))
+         sibling = mOwner->mComponentTypeSlots[ref->mTypeId];
+
+      ref->mComponent = (sibling != this) ? sibling : NULL;
+   }
+}
+
 void Component::componentAddedToOwner(Component *comp)
 {
    return;
@@ -232,7 +270,16 @@ void Component::componentRemovedFromOwner(Component *comp)
 void Component::setMaskBits(U32 orMask)
 {
    AssertFatal(orMask != 0, "Invalid net mask bits set.");
-   
+
+   //the entity's net state is shared with every connection, so only touch it from the main thread
+   if (ComponentTickScheduler::isDeferringCalls())
+   {
+      ComponentTickScheduler::deferCall(this, [orMask](SimObject* obj) {
+         static_cast<Component*>(obj)->setMaskBits(orMask);
+      });
+      return;
+   }
+
    if (mOwner)
       mOwner->setComponentNetMask(this, orMask);
 }
@@ -356,6 +403,13 @@ void Component::setDataField(StringTableEntry slotName, const char *array, const
 {
    Parent::setDataField(slotName, array, value);
 
+   if (mOwner)
+      mOwner->wakeUp();
+
+   //our owner indexes us by type, so let it know if that changed out from under it
+   if (mOwner && slotName == StringTable->insert("componentType"))
+      mOwner->rebuildComponentTypeIndex();
+
    onDataSet.trigger(this, slotName, value);
 }
 
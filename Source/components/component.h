@@ -34,6 +34,18 @@
 #ifndef _ASSET_PTR_H_
 #include "assets/assetPtr.h"
 #endif 
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#include "componentTypeRegistry.h"
+#endif
+#ifndef COMPONENT_TICK_SCHEDULER_H
+#include "componentTickScheduler.h"
+#endif
+#ifndef COMPONENT_REF_H
+#include "componentRef.h"
+#endif
+#ifndef ENTITY_OBJECT_POOL_H
+#include "../entityObjectPool.h"
+#endif
 
 class Entity;
 class Namespace;
@@ -45,6 +57,7 @@ class Namespace;
 class Component : public SimObject
 {
    typedef SimObject Parent;
+   friend class ComponentTickScheduler;
 
 protected:
    StringTableEntry mFriendlyName;
@@ -69,10 +82,27 @@ protected:
 
    bool                 mIsServerObject;
 
+   //Our slot in the tick scheduler's batch for our type, -1 if we're not scheduled
+   S32                  mTickIndex;
+
+   //Our slot in our owner's networked component table, -1 if we don't have one
+   S32                  mNetSlot;
+
+   //Our ComponentRef members, chained together, and the type bits they're after
+   friend class ComponentRefBase;
+   ComponentRefBase*    mComponentRefs;
+   ComponentTypeMask    mComponentRefMask;
+
+   friend class Entity;
+   void rebindComponentRefs(ComponentTypeMask changedTypes);
+
 public:
    Component();
    virtual ~Component();
    DECLARE_CONOBJECT(Component);
+   DECLARE_COMPONENT_TYPE_ROOT(Component);
+
+   DECLARE_ENTITY_POOL_ALLOCATOR();
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -90,8 +120,18 @@ public:
    //This is called when a different component is removed from our owner entity
    virtual void componentRemovedFromOwner(Component *comp);  
 
-   //Overridden by components that actually care
+   enum TransformChannels
+   {
+      WorldTransformChannel = BIT(0),  ///< ownerTransformSet(), whenever the owner is moved
+      RenderTransformChannel = BIT(1)  ///< ownerRenderTransformSet(), whenever the owner's render transform changes, including client interpolation
+   };
+
+   /// The owner transform notifications this component wants. The owner only calls the hooks
+   /// below on components that ask for them, so override this alongside them.
+   virtual U32 getTransformChannels() const { return 0; }
+
    virtual void ownerTransformSet(MatrixF *mat) {}
+   virtual void ownerRenderTransformSet(MatrixF *mat) {}
 
    void setOwner(Entity* pOwner);
    inline Entity *getOwner() { return mOwner ? mOwner : NULL; }
@@ -108,6 +148,18 @@ public:
    virtual void interpolateTick(F32 dt){}
    virtual void advanceTime(F32 dt){}
 
+   //Which tick scheduler phase this component type's processTick runs in
+   virtual U32 getTickPhase() const { return ComponentTickScheduler::GamePhase; }
+
+   //Whether this component type's processTick can run on a worker thread alongside the same
+   //type on other entities. Anything that touches script or other objects has to go through
+   //ComponentTickScheduler::deferCall.
+   virtual bool isTickThreadSafe() const { return false; }
+
+   //Whether we've got nothing to do right now, so our owner is allowed to go dormant. Components with a
+   //processTick are assumed busy unless they say otherwise.
+   virtual bool isIdle() { return !(getUpdateHooks() & ComponentTypeRegistry::TickHook); }
+
    StringTableEntry getComponentType() { return mComponentType; }
 
    const char *getDescriptionText(const char *desc);
@@ -151,6 +203,10 @@ public:
 
    virtual U32 packUpdate(NetConnection *con, U32 mask, BitStream *stream);
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
+
+   /// Where our pending update falls among our owner's others for con, highest first. ownerPriority
+   /// is the owner's own priority for the connection.
+   virtual F32 getNetUpdatePriority(NetConnection *con, F32 ownerPriority) { return ownerPriority; }
    /// @}
 
    Signal< void(SimObject*, String, String) > onDataSet;
@@ -0,0 +1,81 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+#pragma once
+
+#ifndef COMPONENT_REF_H
+#define COMPONENT_REF_H
+
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#include "componentTypeRegistry.h"
+#endif
+
+class Component;
+
+//////////////////////////////////////////////////////////////////////////
+/// Untyped half of ComponentRef. Refs chain themselves onto the component that
+/// holds them, so the owner entity can rebind them when its component set changes.
+//////////////////////////////////////////////////////////////////////////
+class ComponentRefBase
+{
+   friend class Component;
+
+   ComponentRefBase(const ComponentRefBase&);
+   ComponentRefBase& operator=(const ComponentRefBase&);
+
+protected:
+   Component*        mComponent;
+   U32               mTypeId;
+   ComponentRefBase* mNext;
+
+   ComponentRefBase(Component* holder, U32 typeId);
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// Handle to a sibling component of type T on the holder's owner.
+///
+/// Declare it as a member of the component that wants the sibling and construct it
+/// with the holder, ie: mOwnerShapeComponent(this). The owner keeps it pointed at its
+/// first T (the same one getComponent<T>() would find) as components come and go, and
+/// clears it when the holder leaves its owner. A ref never binds to its own holder.
+///
+/// Rebinding only updates the pointer. Anything hooked up to the sibling, such as
+/// signals, is still the holder's job in componentAddedToOwner/componentRemovedFromOwner.
+//////////////////////////////////////////////////////////////////////////
+template <class T>
+class ComponentRef : public ComponentRefBase
+{
+public:
+   explicit ComponentRef(Component* holder) : ComponentRefBase(holder, T::getStaticComponentTypeId()) {}
+
+   //slots only ever hold components whose type mask includes T, so this is safe
+   T* get() const { return static_cast<T*>(mComponent); }
+
+   operator T*() const { return get(); }
+   T* operator->() const { return get(); }
+
+   bool isValid() const { return mComponent != NULL; }
+};
+
+#endif // COMPONENT_REF_H
@@ -0,0 +1,483 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "componentTickScheduler.h"
+#include "component.h"
+#include "platform/profiler.h"
+#include "console/simBase.h"
+#include "T3D/gameBase/gameProcess.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+S32 ComponentTickScheduler::smWorkerThreadCount = 0;
+S32 ComponentTickScheduler::smMinParallelBatchSize = 64;
+
+namespace
+{
+   struct DeferredCall
+   {
+      SimObject* object;
+      SimObjectId objectId;
+      std::function<void(SimObject*)> fn;
+   };
+
+   //The deferred call list for the thread we're on, only set while running a parallel batch
+   thread_local std::vector<DeferredCall>* tDeferredCalls = NULL;
+
+   void tickComponents(Component** components, U32 count)
+   {
+      for (U32 i = 0; i < count; i++)
+      {
+         Component* comp = components[i];
+
+         if (comp != NULL && comp->getOwner()->isTicking())
+            comp->processTick();
+      }
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// A fixed set of worker threads, each with its own deque of work. A batch is
+/// cut into ranges that are dealt out round-robin, every thread works from the
+/// front of its own deque and steals from the back of the others once it runs dry.
+/// The main thread takes part as queue 0 rather than sitting idle.
+//////////////////////////////////////////////////////////////////////////
+class ComponentWorkerPool
+{
+public:
+   enum
+   {
+      RangeSize = 16
+   };
+
+   ComponentWorkerPool(U32 threadCount);
+   ~ComponentWorkerPool();
+
+   U32 getThreadCount() const { return mQueueCount - 1; }
+
+   void runBatch(Vector<Component*>& components);
+
+private:
+   struct WorkRange
+   {
+      Component** components;
+      U32 count;
+   };
+
+   struct WorkerQueue
+   {
+      std::mutex mutex;
+      std::deque<WorkRange> work;
+      std::vector<DeferredCall> deferredCalls;
+   };
+
+   void workerMain(U32 queueIdx);
+   void drain(U32 queueIdx);
+   bool popWork(U32 queueIdx, WorkRange& outRange);
+   void flushDeferredCalls();
+
+   WorkerQueue* mQueues;
+   U32 mQueueCount;
+
+   std::vector<std::thread> mThreads;
+
+   std::mutex mWakeMutex;
+   std::condition_variable mWakeCondition;
+   U32 mGeneration;
+   bool mShutdown;
+
+   std::atomic<S32> mPendingRanges;
+};
+
+ComponentWorkerPool::ComponentWorkerPool(U32 threadCount)
+{
+   mQueueCount = threadCount + 1;
+   mQueues = new WorkerQueue[mQueueCount];
+
+   mGeneration = 0;
+   mShutdown = false;
+   mPendingRanges = 0;
+
+   for (U32 i = 1; i < mQueueCount; i++)
+      mThreads.push_back(std::thread(&ComponentWorkerPool::workerMain, this, i));
+}
+
+ComponentWorkerPool::~ComponentWorkerPool()
+{
+   {
+      std::lock_guard<std::mutex> lock(mWakeMutex);
+      mShutdown = true;
+   }
+   mWakeCondition.notify_all();
+
+   for (U32 i = 0; i < mThreads.size(); i++)
+      mThreads[i].join();
+
+   delete[] mQueues;
+}
+
+void ComponentWorkerPool::workerMain(U32 queueIdx)
+{
+   tDeferredCalls = &mQueues[queueIdx].deferredCalls;
+
+   U32 seenGeneration = 0;
+
+   while (true)
+   {
+      {
+         std::unique_lock<std::mutex> lock(mWakeMutex);
+         mWakeCondition.wait(lock, [&]() { return mShutdown || mGeneration != seenGeneration; });
+
+         if (mShutdown)
+            return;
+
+         seenGeneration = mGeneration;
+      }
+
+      drain(queueIdx);
+   }
+}
+
+bool ComponentWorkerPool::popWork(U32 queueIdx, WorkRange& outRange)
+{
+   //our own work first, oldest first
+   {
+      WorkerQueue& queue = mQueues[queueIdx];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      if (!queue.work.empty())
+      {
+         outRange = queue.work.front();
+         queue.work.pop_front();
+         return true;
+      }
+   }
+
+   //then steal from the back of everyone else's
+   for (U32 i = 1; i < mQueueCount; i++)
+   {
+      WorkerQueue& victim = mQueues[(queueIdx + i) % mQueueCount];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+
+      if (!victim.work.empty())
+      {
+         outRange = victim.work.back();
+         victim.work.pop_back();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+void ComponentWorkerPool::drain(U32 queueIdx)
+{
+   WorkRange range;
+   while (mPendingRanges.load(std::memory_order_acquire) > 0 && popWork(queueIdx, range))
+   {
+      tickComponents(range.components, range.count);
+      mPendingRanges.fetch_sub(1, std::memory_order_acq_rel);
+   }
+}
+
+void ComponentWorkerPool::runBatch(Vector<Component*>& components)
+{
+   const U32 componentCount = components.size();
+   const U32 rangeCount = (componentCount + RangeSize - 1) / RangeSize;
+
+   mPendingRanges.store(rangeCount, std::memory_order_release);
+
+   for (U32 r = 0; r < rangeCount; r++)
+   {
+      WorkRange range;
+      range.components = components.address() + r * RangeSize;
+      range.count = getMin((U32)RangeSize, componentCount - r * RangeSize);
+
+      WorkerQueue& queue = mQueues[r % mQueueCount];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.work.push_back(range);
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mWakeMutex);
+      mGeneration++;
+   }
+   mWakeCondition.notify_all();
+
+   //pitch in, then wait on anything still in flight on the workers
+   tDeferredCalls = &mQueues[0].deferredCalls;
+   drain(0);
+   tDeferredCalls = NULL;
+
+   while (mPendingRanges.load(std::memory_order_acquire) > 0)
+      std::this_thread::yield();
+
+   flushDeferredCalls();
+}
+
+void ComponentWorkerPool::flushDeferredCalls()
+{
+   for (U32 q = 0; q < mQueueCount; q++)
+   {
+      std::vector<DeferredCall>& calls = mQueues[q].deferredCalls;
+
+      for (U32 i = 0; i < calls.size(); i++)
+      {
+         //an earlier callback may have deleted the object, so make sure it's still the one we queued
+         SimObject* obj = Sim::findObject(calls[i].objectId);
+
+         if (obj != NULL && obj == calls[i].object)
+            calls[i].fn(obj);
+      }
+
+      calls.clear();
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+ComponentTickScheduler::ComponentTickScheduler()
+{
+   for (U32 i = 0; i < ComponentTypeRegistry::MaxComponentTypes; i++)
+      mTypeBatches[i] = NULL;
+
+   mWorkerPool = NULL;
+
+   mHooked = false;
+   mTicking = false;
+}
+
+ComponentTickScheduler::~ComponentTickScheduler()
+{
+   if (mHooked)
+      ServerProcessList::get()->preTickSignal().remove(this, &ComponentTickScheduler::onPreTick);
+
+   for (U32 i = 0; i < mBatches.size(); i++)
+      delete mBatches[i];
+
+   for (U32 i = 0; i < mPendingBatches.size(); i++)
+      delete mPendingBatches[i];
+
+   mBatches.clear();
+   mPendingBatches.clear();
+
+   delete mWorkerPool;
+}
+
+ComponentTickScheduler* ComponentTickScheduler::getServer()
+{
+   static ComponentTickScheduler sServerScheduler;
+   return &sServerScheduler;
+}
+
+void ComponentTickScheduler::hook()
+{
+   if (mHooked)
+      return;
+
+   ServerProcessList::get()->preTickSignal().notify(this, &ComponentTickScheduler::onPreTick);
+   mHooked = true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+ComponentTickScheduler::TickBatch* ComponentTickScheduler::findOrCreateBatch(Component* comp)
+{
+   const U32 typeId = comp->getComponentTypeId();
+
+   if (mTypeBatches[typeId] != NULL)
+      return mTypeBatches[typeId];
+
+   TickBatch* batch = new TickBatch();
+   batch->typeId = typeId;
+   batch->phase = comp->getTickPhase();
+   batch->hasHoles = false;
+   batch->threadSafe = comp->isTickThreadSafe();
+
+   AssertFatal(batch->phase < TickPhaseCount, "ComponentTickScheduler::findOrCreateBatch() - Invalid tick phase.");
+
+   mTypeBatches[typeId] = batch;
+
+   //don't reshuffle the batch list out from under a tick in progress, it'll get slotted in after
+   if (mTicking)
+      mPendingBatches.push_back(batch);
+   else
+      insertBatch(batch);
+
+   return batch;
+}
+
+void ComponentTickScheduler::insertBatch(TickBatch* batch)
+{
+   //keep the batch list in phase order, and type order inside a phase so it's deterministic
+   U32 insertIdx = 0;
+   while (insertIdx < mBatches.size())
+   {
+      const TickBatch* other = mBatches[insertIdx];
+
+      if (other->phase > batch->phase || (other->phase == batch->phase && other->typeId > batch->typeId))
+         break;
+
+      insertIdx++;
+   }
+
+   mBatches.insert(insertIdx, batch);
+}
+
+void ComponentTickScheduler::registerComponent(Component* comp)
+{
+   //nothing to do for components that don't actually implement processTick
+   if (comp->mTickIndex != -1 || !(comp->getUpdateHooks() & ComponentTypeRegistry::TickHook))
+      return;
+
+   hook();
+
+   TickBatch* batch = findOrCreateBatch(comp);
+
+   comp->mTickIndex = batch->components.size();
+   batch->components.push_back(comp);
+}
+
+void ComponentTickScheduler::unregisterComponent(Component* comp)
+{
+   if (comp->mTickIndex == -1)
+      return;
+
+   TickBatch* batch = mTypeBatches[comp->getComponentTypeId()];
+
+   AssertFatal(batch && batch->components[comp->mTickIndex] == comp, "ComponentTickScheduler::unregisterComponent() - Component is not where we left it.");
+
+   if (mTicking)
+   {
+      //we're partway through walking the batches, so leave a hole and tidy up after
+      batch->components[comp->mTickIndex] = NULL;
+      batch->hasHoles = true;
+   }
+   else
+   {
+      Component* last = batch->components.last();
+      batch->components[comp->mTickIndex] = last;
+      last->mTickIndex = comp->mTickIndex;
+      batch->components.pop_back();
+   }
+
+   comp->mTickIndex = -1;
+}
+
+void ComponentTickScheduler::runBatch(TickBatch* batch)
+{
+   Vector<Component*>& components = batch->components;
+
+   if (mWorkerPool && batch->threadSafe && components.size() >= smMinParallelBatchSize)
+   {
+      //components can't be added to or removed from the batch while it's in flight, as anything
+      //that could do so from a thread-safe tick has to go through deferCall
+      mWorkerPool->runBatch(components);
+      return;
+   }
+
+   //components added partway through the tick are picked up by the size check
+   for (U32 i = 0; i < components.size(); i++)
+   {
+      Component* comp = components[i];
+
+      if (comp != NULL && comp->getOwner()->isTicking())
+         comp->processTick();
+   }
+}
+
+bool ComponentTickScheduler::isDeferringCalls()
+{
+   return tDeferredCalls != NULL;
+}
+
+void ComponentTickScheduler::deferCall(SimObject* obj, const std::function<void(SimObject*)>& fn)
+{
+   if (tDeferredCalls == NULL)
+   {
+      fn(obj);
+      return;
+   }
+
+   DeferredCall call;
+   call.object = obj;
+   call.objectId = obj->getId();
+   call.fn = fn;
+
+   tDeferredCalls->push_back(call);
+}
+
+void ComponentTickScheduler::compactBatch(TickBatch* batch)
+{
+   U32 writeIdx = 0;
+   for (U32 i = 0; i < batch->components.size(); i++)
+   {
+      Component* comp = batch->components[i];
+      if (comp == NULL)
+         continue;
+
+      comp->mTickIndex = writeIdx;
+      batch->components[writeIdx++] = comp;
+   }
+
+   batch->components.setSize(writeIdx);
+   batch->hasHoles = false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ComponentTickScheduler::tick()
+{
+   PROFILE_SCOPE(ComponentTickScheduler_tick);
+
+   //spin the worker pool up or down if the thread count was changed
+   const U32 workerCount = (U32)getMax(smWorkerThreadCount, 0);
+   if (mWorkerPool && mWorkerPool->getThreadCount() != workerCount)
+   {
+      delete mWorkerPool;
+      mWorkerPool = NULL;
+   }
+
+   if (!mWorkerPool && workerCount > 0)
+      mWorkerPool = new ComponentWorkerPool(workerCount);
+
+   mTicking = true;
+
+   for (U32 b = 0; b < mBatches.size(); b++)
+      runBatch(mBatches[b]);
+
+   mTicking = false;
+
+   for (U32 i = 0; i < mPendingBatches.size(); i++)
+      insertBatch(mPendingBatches[i]);
+
+   mPendingBatches.clear();
+
+   for (U32 b = 0; b < mBatches.size(); b++)
+   {
+      if (mBatches[b]->hasHoles)
+         compactBatch(mBatches[b]);
+   }
+}
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#pragma once
+
+#ifndef COMPONENT_TICK_SCHEDULER_H
+#define COMPONENT_TICK_SCHEDULER_H
+
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#include "componentTypeRegistry.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+#include <functional>
+
+class Component;
+class SimObject;
+class ComponentWorkerPool;
+
+//////////////////////////////////////////////////////////////////////////
+/// Ticks components in batches of the same native type instead of per entity.
+///
+/// Components are registered when they are added to an entity and grouped by
+/// their concrete component type id. Components whose class doesn't override
+/// processTick are never registered, so they cost nothing per tick. Each tick the batches are run in phase
+/// order, and in type id order within a phase, so every component of one type
+/// is processed back to back.
+///
+/// Only server objects are scheduled. Client ghosts keep ticking their
+/// components from Entity::processTick, as prediction replays re-tick a single
+/// entity several times within one process list tick.
+///
+/// The batches run from the server process list's pre-tick signal, so a server
+/// tick goes:
+///   1. Every scheduled component, batch by batch in TickPhase order.
+///   2. Each entity's own step (warp, move, mounting and script processTick), in
+///      process list order, so processAfter still orders mounted entities after
+///      what they're mounted to.
+/// Components therefore all see the world as the previous tick left it. A
+/// component on a mounted entity ticks before its parent has moved this tick,
+/// and controllers see other entities' state from the previous tick, just as
+/// they see their own.
+///
+/// Batches of component types that report isTickThreadSafe() are spread over a
+/// work-stealing pool of worker threads. Anything that has to happen on the main
+/// thread, such as script callbacks and net mask updates, goes through deferCall()
+/// and is run once the whole batch has finished.
+//////////////////////////////////////////////////////////////////////////
+class ComponentTickScheduler
+{
+public:
+   /// The order batches are run in during a tick. Components pick theirs by
+   /// overriding Component::getTickPhase().
+   enum TickPhase
+   {
+      GamePhase = 0,    ///< General game logic, triggers, state machines and the like
+      PhysicsPhase,     ///< Movement and controllers
+      CollisionPhase,   ///< Collision tests against the newly moved positions
+      AnimationPhase,   ///< Animation threads, after movement is resolved
+      CameraPhase,      ///< Anything following the final transforms of other objects
+      TickPhaseCount
+   };
+
+   ComponentTickScheduler();
+   ~ComponentTickScheduler();
+
+   static ComponentTickScheduler* getServer();
+
+   /// Number of worker threads used for thread-safe batches. 0 keeps everything
+   /// on the main thread. Exposed to script as $Entity::componentTickThreads.
+   static S32 smWorkerThreadCount;
+
+   /// Batches smaller than this aren't worth waking the workers for.
+   static S32 smMinParallelBatchSize;
+
+   /// True while the calling thread is running part of a parallel batch.
+   static bool isDeferringCalls();
+
+   /// Runs fn on obj on the main thread. During a parallel batch the call is queued
+   /// until the batch is done, and dropped if obj was deleted in the meantime.
+   /// Otherwise it runs immediately.
+   static void deferCall(SimObject* obj, const std::function<void(SimObject*)>& fn);
+
+   void registerComponent(Component* comp);
+   void unregisterComponent(Component* comp);
+
+   /// Runs every batch once. Called from the server process list's pre-tick signal.
+   void tick();
+
+private:
+   void hook();
+   void onPreTick() { tick(); }
+
+   struct TickBatch
+   {
+      U32 typeId;
+      U32 phase;
+      Vector<Component*> components;
+      bool hasHoles;
+      bool threadSafe;
+   };
+
+   void runBatch(TickBatch* batch);
+
+   TickBatch* findOrCreateBatch(Component* comp);
+   void insertBatch(TickBatch* batch);
+   void compactBatch(TickBatch* batch);
+
+   //sorted by phase, then type id
+   Vector<TickBatch*> mBatches;
+   TickBatch* mTypeBatches[ComponentTypeRegistry::MaxComponentTypes];
+
+   //batches created while a tick was running, merged into mBatches once it's done
+   Vector<TickBatch*> mPendingBatches;
+
+   ComponentWorkerPool* mWorkerPool;
+
+   bool mHooked;
+   bool mTicking;
+};
+
+#endif // COMPONENT_TICK_SCHEDULER_H
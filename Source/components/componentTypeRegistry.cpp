@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "componentTypeRegistry.h"
+#include "console/console.h"
+
+U32 ComponentTypeRegistry::smTypeCount = 0;
+const char* ComponentTypeRegistry::smTypeNames[ComponentTypeRegistry::MaxComponentTypes];
+
+U32 ComponentTypeRegistry::registerType(const char* className)
+{
+   //a type may have been looked up by name before its class first asked for an id
+   S32 existingId = findTypeId(className);
+   if (existingId != -1)
+      return existingId;
+
+   //Every type needs its own bit in a ComponentTypeMask, and type ids index fixed size tables all over,
+   //so there's no running on past this. AssertISV, unlike AssertFatal, stops release builds too
+   if (smTypeCount >= MaxComponentTypes)
+   {
+      const char* error = avar("ComponentTypeRegistry::registerType() - Too many component types registering %s, increase MaxComponentTypes.", className);
+
+      Con::errorf("%s", error);
+      AssertISV(false, error);
+   }
+
+   smTypeNames[smTypeCount] = className;
+
+   return smTypeCount++;
+}
+
+const char* ComponentTypeRegistry::getTypeName(U32 typeId)
+{
+   if (typeId >= smTypeCount)
+      return "";
+
+   return smTypeNames[typeId];
+}
+
+S32 ComponentTypeRegistry::findTypeId(const char* className)
+{
+   for (U32 i = 0; i < smTypeCount; i++)
+   {
+      if (!dStricmp(smTypeNames[i], className))
+         return i;
+   }
+
+   return -1;
+}
@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#pragma once
+
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#define COMPONENT_TYPE_REGISTRY_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#include <type_traits>
+
+//One bit per registered component class
+typedef U64 ComponentTypeMask;
+
+//////////////////////////////////////////////////////////////////////////
+/// Hands out dense integer ids to the native Component classes.
+///
+/// Ids are assigned the first time a class asks for its id, so the numbering is
+/// only stable for the lifetime of the process and must never be saved or sent
+/// over the network. Each class's type mask contains its own bit plus the bits
+/// of all of its parent component classes, so a query for a base type also
+/// finds derived components.
+///
+/// This header intentionally doesn't include component.h or entity.h, as both
+/// of those need it.
+//////////////////////////////////////////////////////////////////////////
+class ComponentTypeRegistry
+{
+public:
+   enum
+   {
+      MaxComponentTypes = 64
+   };
+
+   /// The per-tick update functions a component class actually implements.
+   enum UpdateHooks
+   {
+      TickHook = BIT(0),          ///< Overrides processTick()
+      InterpolateHook = BIT(1),   ///< Overrides interpolateTick()
+      AdvanceHook = BIT(2)        ///< Overrides advanceTime()
+   };
+
+   /// Works out which update hooks className overrides from baseClassName, by
+   /// checking which class the member function pointers resolve to.
+   template <class className, class baseClassName>
+   static U32 detectUpdateHooks()
+   {
+      U32 hooks = 0;
+
+      if (!std::is_same<decltype(&className::processTick), void (baseClassName::*)()>::value)
+         hooks |= TickHook;
+      if (!std::is_same<decltype(&className::interpolateTick), void (baseClassName::*)(F32)>::value)
+         hooks |= InterpolateHook;
+      if (!std::is_same<decltype(&className::advanceTime), void (baseClassName::*)(F32)>::value)
+         hooks |= AdvanceHook;
+
+      return hooks;
+   }
+
+   static U32 registerType(const char* className);
+
+   static U32 getTypeCount() { return smTypeCount; }
+   static const char* getTypeName(U32 typeId);
+   static S32 findTypeId(const char* className);
+
+   static inline ComponentTypeMask getTypeBit(U32 typeId)
+   {
+      return ComponentTypeMask(1) << typeId;
+   }
+
+private:
+   static U32 smTypeCount;
+   static const char* smTypeNames[MaxComponentTypes];
+};
+
+/// Declares the component type id, type mask and update hooks for a Component
+/// subclass. Place it in the public section of the class, next to DECLARE_CONOBJECT.
+/// parentClassName is the component class this one actually derives from.
+#define DECLARE_COMPONENT_TYPE(className, parentClassName)                                         \
+   static U32 getStaticComponentTypeId()                                                          \
+   {                                                                                              \
+      static const U32 sTypeId = ComponentTypeRegistry::registerType(#className);                \
+      return sTypeId;                                                                             \
+   }                                                                                              \
+   static ComponentTypeMask getStaticComponentTypeMask()                                          \
+   {                                                                                              \
+      static const ComponentTypeMask sTypeMask = parentClassName::getStaticComponentTypeMask() |  \
+         ComponentTypeRegistry::getTypeBit(getStaticComponentTypeId());                          \
+      return sTypeMask;                                                                           \
+   }                                                                                              \
+   static U32 getStaticUpdateHooks()                                                              \
+   {                                                                                              \
+      return ComponentTypeRegistry::detectUpdateHooks<className, Component>();                    \
+   }                                                                                              \
+   virtual U32 getComponentTypeId() const { return getStaticComponentTypeId(); }                  \
+   virtual ComponentTypeMask getComponentTypeMask() const { return getStaticComponentTypeMask(); } \
+   virtual U32 getUpdateHooks() const { return getStaticUpdateHooks(); }
+
+/// Only used by Component itself, as it has no parent component class.
+#define DECLARE_COMPONENT_TYPE_ROOT(className)                                                     \
+   static U32 getStaticComponentTypeId()                                                          \
+   {                                                                                              \
+      static const U32 sTypeId = ComponentTypeRegistry::registerType(#className);                \
+      return sTypeId;                                                                             \
+   }                                                                                              \
+   static ComponentTypeMask getStaticComponentTypeMask()                                          \
+   {                                                                                              \
+      return ComponentTypeRegistry::getTypeBit(getStaticComponentTypeId());                       \
+   }                                                                                              \
+   static U32 getStaticUpdateHooks() { return 0; }                                                \
+   virtual U32 getComponentTypeId() const { return getStaticComponentTypeId(); }                  \
+   virtual ComponentTypeMask getComponentTypeMask() const { return getStaticComponentTypeMask(); } \
+   virtual U32 getUpdateHooks() const { return getStaticUpdateHooks(); }
+
+#endif // COMPONENT_TYPE_REGISTRY_H
@@ -31,7 +31,7 @@ ControlObjectComponent::ControlObjectComponent() : Component(),
    mOwnerConnectionId(0)
 {
    mFriendlyName = "Control Object";
-   mComponentType = "Game";
+   mComponentType = StringTable->insert("Game");
 
    mDescription = getDescriptionText("Allows owner entity to be controlled by a client.");
 }
@@ -16,6 +16,7 @@ public:
    ~ControlObjectComponent();
 
    DECLARE_CONOBJECT(ControlObjectComponent);
+   DECLARE_COMPONENT_TYPE(ControlObjectComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -101,11 +101,6 @@ void FollowPathComponent::interpolateMat(F32 pos, MatrixF* mat)
    mat->setPosition(knot.mPosition);*/
 }
 
-void FollowPathComponent::advanceTime(F32 dt) 
-{
-   Parent::advanceTime(dt);
-}
-
 void FollowPathComponent::advancePosition(S32 ms)
 {
    /*delta.timeVec = mPosition;
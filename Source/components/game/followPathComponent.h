@@ -46,6 +46,7 @@ class FollowPathComponent : public Component
 
 public:
    DECLARE_CONOBJECT(FollowPathComponent);
+   DECLARE_COMPONENT_TYPE(FollowPathComponent, Component);
 
    FollowPathComponent();
    ~FollowPathComponent();
@@ -61,7 +62,6 @@ public:
 
    virtual void processTick();
    virtual void interpolateTick(F32 dt);
-   virtual void advanceTime(F32 dt);
 
    //
    //void onEditorEnable();
@@ -36,7 +36,7 @@ InteractComponent::InteractComponent() : Component(),
    mUseNaturalReach(false)
 {
    mFriendlyName = "Interact";
-   mComponentType = "Game";
+   mComponentType = StringTable->insert("Game");
 
    mDescription = getDescriptionText("Allows owner entity interact.");
 }
@@ -112,7 +112,7 @@ void InteractComponent::processTick()
       {
          //call on that badboy!
          //TODO: optimize out the stringtable insert by caching as a static
-         InteractableComponent* iComp = hitEntity->getComponent<InteractableComponent>(StringTable->insert("interactableComponent"));
+         InteractableComponent* iComp = hitEntity->getComponent<InteractableComponent>();
 
          if (iComp)
          {
@@ -136,7 +136,7 @@ void InteractComponent::processTick()
       while (e != nullptr)
       {
          //TODO: optimize out the stringtable insert by caching as a static
-         InteractableComponent* iComp = e->getComponent<InteractableComponent>(StringTable->insert("interactableComponent"));
+         InteractableComponent* iComp = e->getComponent<InteractableComponent>();
 
          if (iComp != nullptr)
          {
@@ -166,7 +166,7 @@ void InteractComponent::processTick()
       {
          //call on that badboy!
          //TODO: optimize out the stringtable insert by caching as a static
-         InteractableComponent* iComp = bestFitEntity->getComponent<InteractableComponent>(StringTable->insert("interactableComponent"));
+         InteractableComponent* iComp = bestFitEntity->getComponent<InteractableComponent>();
 
          iComp->interact(this);
       }
@@ -21,6 +21,7 @@ public:
    ~InteractComponent();
 
    DECLARE_CONOBJECT(InteractComponent);
+   DECLARE_COMPONENT_TYPE(InteractComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -29,7 +29,7 @@ InteractableComponent::InteractableComponent() : Component(),
    mInteractableWeight(1)
 {
    mFriendlyName = "Interactable";
-   mComponentType = "Game";
+   mComponentType = StringTable->insert("Game");
 
    mDescription = getDescriptionText("Allows owner entity to be interacted with.");
 }
@@ -75,7 +75,9 @@ void InteractableComponent::interact(InteractComponent* interactor)
 {
    if (interactor != nullptr)
    {
-      mOwner->notifyComponents("onInteract", interactor->getIdString());
+      static const EntityEventId sInteractEvent = EntityEventRegistry::getEventId("onInteract");
+
+      mOwner->fireEvent(EntityEvent(sInteractEvent).addObject(interactor));
 
       if(isMethod("onInteract"))
          Con::executef(this, "onInteract", interactor);
@@ -86,7 +88,9 @@ void InteractableComponent::interact(InteractComponent* interactor, RayInfo rayI
 {
    if (interactor != nullptr)
    {
-      mOwner->notifyComponents("onInteract", interactor->getIdString());
+      static const EntityEventId sInteractEvent = EntityEventRegistry::getEventId("onInteract");
+
+      mOwner->fireEvent(EntityEvent(sInteractEvent).addObject(interactor));
 
       if (isMethod("onInteract"))
          Con::executef(this, "onInteract", interactor);
@@ -15,6 +15,7 @@ public:
    ~InteractableComponent();
 
    DECLARE_CONOBJECT(InteractableComponent);
+   DECLARE_COMPONENT_TYPE(InteractableComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -49,7 +49,7 @@ IMPLEMENT_CALLBACK( StateMachineComponent, onStateChange, void, (), (),
 StateMachineComponent::StateMachineComponent() : Component()
 {
    mFriendlyName = "State Machine";
-   mComponentType = "Game";
+   mComponentType = StringTable->insert("Game");
 
    mDescription = getDescriptionText("A generic state machine.");
 
@@ -48,6 +48,7 @@ public:
    StateMachineComponent();
    virtual ~StateMachineComponent();
    DECLARE_CONOBJECT(StateMachineComponent);
+   DECLARE_COMPONENT_TYPE(StateMachineComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
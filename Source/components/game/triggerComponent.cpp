@@ -50,14 +50,15 @@ IMPLEMENT_CALLBACK( TriggerComponent, onUpdateOutOfViewCmd, void,
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
 
-TriggerComponent::TriggerComponent() : Component()
+TriggerComponent::TriggerComponent() : Component(),
+   mOwnerCollisionComp(this)
 {
    mObjectList.clear();
 
    mVisible = false;
 
    mFriendlyName = "Trigger";
-   mComponentType = "Trigger";
+   mComponentType = StringTable->insert("Trigger");
 
    mDescription = getDescriptionText("Calls trigger events when a client starts and stops seeing it. Also ticks while visible to clients.");
 }
@@ -88,21 +89,17 @@ void TriggerComponent::onComponentAdd()
 {
    Parent::onComponentAdd();
 
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-
-   if(colComp)
+   if(mOwnerCollisionComp)
    {
-      colComp->onCollisionSignal.notify(this, &TriggerComponent::potentialEnterObject);
+      mOwnerCollisionComp->onCollisionSignal.notify(this, &TriggerComponent::potentialEnterObject);
    }
 }
 
 void TriggerComponent::onComponentRemove()
 {
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-
-   if(colComp)
+   if(mOwnerCollisionComp)
    {
-      colComp->onCollisionSignal.remove(this, &TriggerComponent::potentialEnterObject);
+      mOwnerCollisionComp->onCollisionSignal.remove(this, &TriggerComponent::potentialEnterObject);
    }
 
    Parent::onComponentRemove();
@@ -113,11 +110,9 @@ void TriggerComponent::componentAddedToOwner(Component *comp)
    if (comp->getId() == getId())
       return;
 
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-
-   if (colComp)
+   if (mOwnerCollisionComp && mOwnerCollisionComp == comp)
    {
-      colComp->onCollisionSignal.notify(this, &TriggerComponent::potentialEnterObject);
+      mOwnerCollisionComp->onCollisionSignal.notify(this, &TriggerComponent::potentialEnterObject);
    }
 }
 
@@ -126,12 +121,19 @@ void TriggerComponent::componentRemovedFromOwner(Component *comp)
    if (comp->getId() == getId()) //?????????
       return;
 
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
+   CollisionComponent *colComp = dynamic_cast<CollisionComponent*>(comp);
 
    if (colComp)
    {
       colComp->onCollisionSignal.remove(this, &TriggerComponent::potentialEnterObject);
    }
+
+   //if another collision component took its place, listen to that one instead
+   if (mOwnerCollisionComp)
+   {
+      mOwnerCollisionComp->onCollisionSignal.remove(this, &TriggerComponent::potentialEnterObject);
+      mOwnerCollisionComp->onCollisionSignal.notify(this, &TriggerComponent::potentialEnterObject);
+   }
 }
 
 void TriggerComponent::initPersistFields()
@@ -210,10 +212,8 @@ bool TriggerComponent::testObject(SceneObject* enter)
       if (!mOwner->getWorldBox().isOverlapped(enterBox))
          return false;
 
-      StringTableEntry colCompType = StringTable->insert("collisionComponent");
-
       //check if the entity has a collision shape
-      CollisionComponent *colComp = enterEntity->getComponent<CollisionComponent>(colCompType);
+      CollisionComponent *colComp = enterEntity->getComponent<CollisionComponent>();
       if (colComp)
       {
          colComp->buildPolyList(PLC_Collision, &mClippedList, mOwner->getWorldBox(), sphere);
@@ -222,7 +222,7 @@ bool TriggerComponent::testObject(SceneObject* enter)
          {
             //well, it's clipped with, or inside, our bounds
             //now to test the clipped list against our own collision mesh
-            CollisionComponent *myColComp = mOwner->getComponent<CollisionComponent>(colCompType);
+            CollisionComponent *myColComp = mOwnerCollisionComp;
 
             //wait, how would we NOT have this?
             if (myColComp)
@@ -34,10 +34,13 @@ protected:
    String mOnExitCommand;
    String mOnUpdateInViewCmd;
 
+   ComponentRef<CollisionComponent> mOwnerCollisionComp;
+
 public:
    TriggerComponent();
    virtual ~TriggerComponent();
    DECLARE_CONOBJECT(TriggerComponent);
+   DECLARE_COMPONENT_TYPE(TriggerComponent, Component);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -103,6 +103,8 @@ public:
    PhysicsComponent();
    virtual ~PhysicsComponent();
    DECLARE_CONOBJECT(PhysicsComponent);
+   DECLARE_COMPONENT_TYPE(PhysicsComponent, Component);
+   virtual U32 getTickPhase() const { return ComponentTickScheduler::PhysicsPhase; }
 
    static void initPersistFields();
 
@@ -131,6 +133,9 @@ public:
    virtual U32 packUpdate(NetConnection *con, U32 mask, BitStream *stream);
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
 
+   //Movement falling behind is what clients notice first, and more so the faster we're going
+   virtual F32 getNetUpdatePriority(NetConnection *con, F32 ownerPriority) { return ownerPriority * (2.0f + mVelocity.len() * 0.1f); }
+
    //Events
    virtual void updateVelocity(const F32 dt);
    
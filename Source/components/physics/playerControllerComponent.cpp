@@ -57,7 +57,8 @@ IMPLEMENT_CALLBACK(PlayerControllerComponent, updateMove, void, (PlayerControlle
 //////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
-PlayerControllerComponent::PlayerControllerComponent() : PhysicsComponent()
+PlayerControllerComponent::PlayerControllerComponent() : PhysicsComponent(),
+   mOwnerCollisionComp(this)
 {
    mBuoyancy = 0.f;
    mFriction = 0.3f;
@@ -80,7 +81,7 @@ PlayerControllerComponent::PlayerControllerComponent() : PhysicsComponent()
    mUseDirectMoveInput = false;
 
    mFriendlyName = "Player Controller";
-   mComponentType = "Physics";
+   mComponentType = StringTable->insert("Physics");
 
    mDescription = getDescriptionText("A general-purpose physics player controller.");
 
@@ -116,7 +117,6 @@ PlayerControllerComponent::PlayerControllerComponent() : PhysicsComponent()
    mPhysicsRep = nullptr;
    mPhysicsWorld = nullptr;
 
-   mOwnerCollisionComp = nullptr;
    mIntegrationCount = 0;
 }
 
@@ -148,12 +148,8 @@ void PlayerControllerComponent::onComponentAdd()
 {
    Parent::onComponentAdd();
 
-   CollisionComponent *collisionComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-   if (collisionComp)
-   {
-      collisionComp->onCollisionChanged.notify(this, &PlayerControllerComponent::updatePhysics);
-      mOwnerCollisionComp = collisionComp;
-   }
+   if (mOwnerCollisionComp)
+      mOwnerCollisionComp->onCollisionChanged.notify(this, &PlayerControllerComponent::updatePhysics);
 
    updatePhysics();
 }
@@ -167,7 +163,6 @@ void PlayerControllerComponent::componentAddedToOwner(Component *comp)
    if (collisionComp)
    {
       collisionComp->onCollisionChanged.notify(this, &PlayerControllerComponent::updatePhysics);
-      mOwnerCollisionComp = collisionComp;
       updatePhysics();
    }
 }
@@ -180,8 +175,7 @@ void PlayerControllerComponent::componentRemovedFromOwner(Component *comp)
    CollisionComponent *collisionComp = dynamic_cast<CollisionComponent*>(comp);
    if (collisionComp)
    {
-      collisionComp->onCollisionChanged.notify(this, &PlayerControllerComponent::updatePhysics);
-      mOwnerCollisionComp = nullptr;
+      collisionComp->onCollisionChanged.remove(this, &PlayerControllerComponent::updatePhysics);
       updatePhysics();
    }
 }
@@ -572,10 +566,9 @@ void PlayerControllerComponent::updatePos(const F32 travelTime)
       haveCollisions = true;
 
       //TODO: clean this up so the phys component doesn't have to tell the col interface to do this
-      CollisionComponent* colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-      if (colComp)
+      if (mOwnerCollisionComp)
       {
-         colComp->handleCollisionList(collisionList, mVelocity);
+         mOwnerCollisionComp->handleCollisionList(collisionList, mVelocity);
       }
    }
 
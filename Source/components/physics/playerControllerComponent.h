@@ -96,7 +96,7 @@ class PlayerControllerComponent : public PhysicsComponent
    PhysicsPlayer *mPhysicsRep;
    PhysicsWorld  *mPhysicsWorld;
 
-   CollisionComponent* mOwnerCollisionComp;
+   ComponentRef<CollisionComponent> mOwnerCollisionComp;
 
    struct ContactInfo
    {
@@ -162,6 +162,7 @@ public:
    PlayerControllerComponent();
    virtual ~PlayerControllerComponent();
    DECLARE_CONOBJECT(PlayerControllerComponent);
+   DECLARE_COMPONENT_TYPE(PlayerControllerComponent, PhysicsComponent);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -172,6 +173,7 @@ public:
    virtual void componentAddedToOwner(Component *comp);
    virtual void componentRemovedFromOwner(Component *comp);
 
+   virtual U32 getTransformChannels() const { return WorldTransformChannel; }
    virtual void ownerTransformSet(MatrixF *mat);
 
    virtual U32 packUpdate(NetConnection *con, U32 mask, BitStream *stream);
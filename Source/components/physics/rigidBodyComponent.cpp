@@ -39,7 +39,8 @@ bool RigidBodyComponent::smNoSmoothing = false;
 //////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
-RigidBodyComponent::RigidBodyComponent() : PhysicsComponent()
+RigidBodyComponent::RigidBodyComponent() : PhysicsComponent(),
+   mOwnerColComponent(this)
 {
    mMass = 20;
    mDynamicFriction = 1;
@@ -57,8 +58,6 @@ RigidBodyComponent::RigidBodyComponent() : PhysicsComponent()
    mPhysicsRep = NULL;
    mResetPos = MatrixF::Identity;
 
-   mOwnerColComponent = NULL;
-
    mFriendlyName = "RigidBody(Component)";
 }
 
@@ -96,11 +95,10 @@ void RigidBodyComponent::onComponentAdd()
       PhysicsPlugin::getPhysicsResetSignal().notify(this, &RigidBodyComponent::_onPhysicsReset);
    }
 
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-   if (colComp)
+   if (mOwnerColComponent)
    {
-      colComp->onCollisionChanged.notify(this, &RigidBodyComponent::updatePhysics);
-      updatePhysics(colComp->getCollisionData());
+      mOwnerColComponent->onCollisionChanged.notify(this, &RigidBodyComponent::updatePhysics);
+      updatePhysics(mOwnerColComponent->getCollisionData());
    }
    else
       updatePhysics();
@@ -115,10 +113,9 @@ void RigidBodyComponent::onComponentRemove()
       PhysicsPlugin::getPhysicsResetSignal().remove(this, &RigidBodyComponent::_onPhysicsReset);
    }
 
-   CollisionComponent *colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
-   if (colComp)
+   if (mOwnerColComponent)
    {
-      colComp->onCollisionChanged.remove(this, &RigidBodyComponent::updatePhysics);
+      mOwnerColComponent->onCollisionChanged.remove(this, &RigidBodyComponent::updatePhysics);
    }
 
    SAFE_DELETE(mPhysicsRep);
@@ -376,10 +373,21 @@ void RigidBodyComponent::storeRestorePos()
    mResetPos = mOwner->getTransform();
 }
 
+bool RigidBodyComponent::isIdle()
+{
+   //Static and sleeping bodies don't move, so there's nothing for us to pull off them
+   return !mPhysicsRep || !mPhysicsRep->isDynamic() || mPhysicsRep->isSleeping();
+}
+
 void RigidBodyComponent::applyImpulse(const Point3F &pos, const VectorF &vec)
 {
    if (mPhysicsRep && mPhysicsRep->isDynamic())
+   {
       mPhysicsRep->applyImpulse(pos, vec);
+
+      //the impulse wakes the body, so we need to be ticking to follow it
+      mOwner->wakeUp();
+   }
 }
 
 void RigidBodyComponent::applyRadialImpulse(const Point3F &origin, F32 radius, F32 magnitude)
@@ -400,6 +408,7 @@ void RigidBodyComponent::applyRadialImpulse(const Point3F &origin, F32 radius, F
       force *= mClampF(radius / dist, 0.0f, 1.0f) * magnitude;
 
    mPhysicsRep->applyImpulse(origin, force);
+   mOwner->wakeUp();
 
    // TODO: There is no simple way to really sync this sort of an 
    // event with the client.
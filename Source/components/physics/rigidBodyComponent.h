@@ -129,7 +129,7 @@ class RigidBodyComponent : public PhysicsComponent
    // The density of this object used for water buoyancy effects.
    F32 mBuoyancyDensity;
 
-   CollisionComponent* mOwnerColComponent;
+   ComponentRef<CollisionComponent> mOwnerColComponent;
 
    enum MaskBits {
       PositionMask = Parent::NextFreeMask << 0,
@@ -143,6 +143,7 @@ public:
    RigidBodyComponent();
    virtual ~RigidBodyComponent();
    DECLARE_CONOBJECT(RigidBodyComponent);
+   DECLARE_COMPONENT_TYPE(RigidBodyComponent, PhysicsComponent);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -154,6 +155,7 @@ public:
    virtual void componentAddedToOwner(Component *comp);
    virtual void componentRemovedFromOwner(Component *comp);
 
+   virtual U32 getTransformChannels() const { return WorldTransformChannel; }
    virtual void ownerTransformSet(MatrixF *mat);
 
    inline F32 getMass() { return mMass; }
@@ -167,6 +169,7 @@ public:
    virtual void unpackUpdate(NetConnection *con, BitStream *stream);
 
    virtual void processTick();
+   virtual bool isIdle();
 
    void findContact();
 
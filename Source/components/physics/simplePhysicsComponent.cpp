@@ -29,7 +29,8 @@ IMPLEMENT_CALLBACK( SimplePhysicsComponent, updateMove, void, ( SimplePhysicsCom
 //////////////////////////////////////////////////////////////////////////
 // Constructor/Destructor
 //////////////////////////////////////////////////////////////////////////
-SimplePhysicsComponent::SimplePhysicsComponent() : PhysicsComponent()
+SimplePhysicsComponent::SimplePhysicsComponent() : PhysicsComponent(),
+   mOwnerCollisionComp(this)
 {
    mBuoyancy = 0.f;
    mFriction = 0.3f;
@@ -44,7 +45,7 @@ SimplePhysicsComponent::SimplePhysicsComponent() : PhysicsComponent()
    moveSpeed = Point3F(1, 1, 1);
 
    mFriendlyName = "Simple Physics";
-   mComponentType = "Physics";
+   mComponentType = StringTable->insert("Physics");
 
    mDescription = getDescriptionText("Simple physics Component that allows gravity and impulses.");
 }
@@ -210,7 +211,7 @@ Point3F SimplePhysicsComponent::_move( const F32 travelTime )
    U32 count = 0;
    S32 sMoveRetryCount = 5;
 
-   CollisionComponent* colComp = mOwner->getComponent<CollisionComponent>(StringTable->insert("collisionComponent"));
+   CollisionComponent* colComp = mOwnerCollisionComp;
 
    if(!colComp)
       return start + mVelocity * time;
@@ -260,7 +261,7 @@ Point3F SimplePhysicsComponent::_move( const F32 travelTime )
             //TODO: Move this somewhere else
             if(Entity* colEnt = dynamic_cast<Entity*>(collision->object))
             {
-               if(CollisionComponent *collidingEntityColComp = colEnt->getComponent<CollisionComponent>(StringTable->insert("collisionComponent")))
+               if(CollisionComponent *collidingEntityColComp = colEnt->getComponent<CollisionComponent>())
                {
                   if(!collidingEntityColComp->doesBlockColliding())
                   {
@@ -276,7 +277,7 @@ Point3F SimplePhysicsComponent::_move( const F32 travelTime )
          //check the last/first one just incase
          if(Entity* colEnt = dynamic_cast<Entity*>(collision->object))
          {
-            if(CollisionComponent *collidingEntityColComp = colEnt->getComponent<CollisionComponent>(StringTable->insert("collisionComponent")))
+            if(CollisionComponent *collidingEntityColComp = colEnt->getComponent<CollisionComponent>())
             {
                if(!collidingEntityColComp->doesBlockColliding())
                {
@@ -34,6 +34,7 @@
 
 class SceneRenderState;
 class PhysicsBody;
+class CollisionComponent;
 //////////////////////////////////////////////////////////////////////////
 /// 
 /// 
@@ -51,6 +52,8 @@ protected:
 
    U32 mIntegrationCount;
 
+   ComponentRef<CollisionComponent> mOwnerCollisionComp;
+
    Point3F moveSpeed;
 
    Point3F mStickyCollisionPos;
@@ -60,6 +63,7 @@ public:
    SimplePhysicsComponent();
    virtual ~SimplePhysicsComponent();
    DECLARE_CONOBJECT(SimplePhysicsComponent);
+   DECLARE_COMPONENT_TYPE(SimplePhysicsComponent, PhysicsComponent);
 
    virtual bool onAdd();
    virtual void onRemove();
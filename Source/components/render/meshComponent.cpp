@@ -146,6 +146,8 @@ void MeshComponent::updateShape()
 
    setupShape();
 
+   markPoseDirty();
+
    //Do this on both the server and client
    S32 materialCount = mMeshAsset->getShape()->materialList->getMaterialNameList().size(); //mMeshAsset->getMaterialCount();
 
@@ -423,7 +425,7 @@ MatrixF MeshComponent::getNodeTransform(S32 nodeIdx)
 
       if(nodeIdx >= 0 && nodeIdx < nodeCount)
       {
-         //animate();
+         updateNodeTransforms();
          MatrixF nodeTransform = mShapeInstance->mNodeTransforms[nodeIdx];
          const Point3F& scale = mOwner->getScale();
 
@@ -557,7 +559,7 @@ void MeshComponent::onEndInspect()
 {
 }
 
-void MeshComponent::ownerTransformSet(MatrixF *mat)
+void MeshComponent::ownerRenderTransformSet(MatrixF *mat)
 {
    MatrixF newTransform = *mat;
    mTransform = newTransform;
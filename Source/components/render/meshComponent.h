@@ -96,6 +96,7 @@ public:
    MeshComponent();
    virtual ~MeshComponent();
    DECLARE_CONOBJECT(MeshComponent);
+   DECLARE_COMPONENT_TYPE(MeshComponent, renderComponent);
 
    virtual bool onAdd();
    virtual void onRemove();
@@ -122,7 +123,8 @@ public:
    virtual void onComponentRemove();
    virtual void onComponentAdd();
 
-   virtual void ownerTransformSet(MatrixF *mat);
+   virtual U32 getTransformChannels() const { return RenderTransformChannel; }
+   virtual void ownerRenderTransformSet(MatrixF *mat);
 
    static bool writeShape(void* obj, StringTableEntry pFieldName) { return static_cast<MeshComponent*>(obj)->mMeshAsset.notNull(); }
 
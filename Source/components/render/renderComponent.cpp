@@ -1,8 +1,24 @@
 #include "renderComponent.h"
+#include "ts/tsShapeInstance.h"
 
 renderComponent::renderComponent()
 {
    mComponentType = StringTable->insert("renderComponent");
+
+   mPoseGeneration = 1;
+   mAnimatedGeneration = 0;
+}
+
+void renderComponent::updateNodeTransforms()
+{
+   if (mAnimatedGeneration == mPoseGeneration)
+      return;
+
+   TSShapeInstance* shapeInstance = getShapeInstance();
+   if (shapeInstance)
+      shapeInstance->animate();
+
+   mAnimatedGeneration = mPoseGeneration;
 }
 
 void renderComponent::render(SceneRenderState* state)
@@ -9,8 +9,21 @@
 
 class renderComponent : public Component
 {
+protected:
+   //Bumped whenever something feeding the node transforms changes, like animation threads advancing or
+   //the shape being swapped out. The shape instance is only re-animated once this has moved on
+   U32 mPoseGeneration;
+   U32 mAnimatedGeneration;
+
 public:
    renderComponent();
+   DECLARE_COMPONENT_TYPE(renderComponent, Component);
+
+   /// Flags the node transforms as stale, to be re-animated the next time someone reads them
+   void markPoseDirty() { mPoseGeneration++; }
+
+   /// Brings the shape instance's node transforms up to date, if the pose changed since they were last animated
+   void updateNodeTransforms();
 
    virtual void render(SceneRenderState* state);
 
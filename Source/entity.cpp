@@ -33,6 +33,7 @@
 #include "T3D/gameBase/gameConnection.h"
 #include "math/mathIO.h"
 #include "math/mTransform.h"
+#include "math/mMathFn.h"
 
 #include "components/render/renderComponent.h"
 #include "components/collision/collisionComponent.h"
@@ -57,6 +58,10 @@
 #include "gui/editor/inspector/group.h"
 #include "inspector/entityGroup.h"
 #include "inspector/componentGroup.h"
+#include "entityTimerWheel.h"
+#include "core/strings/stringUnit.h"
+#include "entityQuery.h"
+#include "entityInterpolation.h"
 
 extern bool gEditingMission;
 
@@ -65,11 +70,144 @@ static F32 sMinWarpTicks = 0.5f;       // Fraction of tick at which instant warp
 static S32 sMaxWarpTicks = 3;          // Max warp duration in ticks
 static S32 sMaxPredictionTicks = 30;   // Number of ticks to predict
 
-static StringTableEntry sRenderComponentType = StringTable->insert("renderComponent");
-static StringTableEntry sCollisionComponentType = StringTable->insert("collisionComponent");
-static StringTableEntry sPhysicsComponentType = StringTable->insert("physicsComponent");
-static StringTableEntry sCameraComponentType = StringTable->insert("cameraComponent");
-static StringTableEntry sAnimationComponentType = StringTable->insert("animationComponent");
+// Transform change detection
+static const F32 sRotationChangeEpsilon = 0.999999f;  // |dot| of old and new rotation quats below this counts as a change
+
+// Transform packing
+static const F32 sPositionDeltaScale = 512.0f;        // Keyframe relative positions go out in 1/512ths of a meter
+static const S32 sPositionDeltaBits = 15;             // Signed, so +/-32m from the keyframe
+static const F32 sKeyframeDistance = 16.0f;           // How far we move before starting a new keyframe
+static const S32 sKeyframeSeqBits = 3;
+
+// Networked components
+static const S32 sNetSlotGenerationBits = 4;
+static const S32 sComponentUpdateLengthBits = 16;    // Bits in a single component's update, so clients can skip it
+static const S32 sQuatComponentBits = 11;
+static const F32 sQuatComponentScale = 1.41421356f;   // The three smallest components of a unit quat are within +/-1/sqrt(2)
+
+S32 Entity::smDormantTickThreshold = 32;
+S32 Entity::smComponentUpdateBudget = 1024;
+
+// Component update priority
+static const F32 sControlledUpdatePriority = 10.0f;   // The entity a connection controls outranks everything else it sees
+static const F32 sUpdatePriorityFalloff = 0.01f;      // Per meter from the connection's camera
+
+struct ComponentUpdateOrder
+{
+   U32 netSlot;
+   F32 priority;
+};
+
+static S32 QSORT_CALLBACK compareComponentUpdateOrder(const void* a, const void* b)
+{
+   const F32 priorityA = ((const ComponentUpdateOrder*)a)->priority;
+   const F32 priorityB = ((const ComponentUpdateOrder*)b)->priority;
+
+   //highest first
+   return (priorityA < priorityB) ? 1 : ((priorityA > priorityB) ? -1 : 0);
+}
+
+// Networked component counts and slots. Small values are by far the common case, so they go out in 4 bit
+// groups, each followed by a flag saying whether more follow
+static void writeNetInt(BitStream* stream, U32 value)
+{
+   do
+   {
+      stream->writeInt(value & 0xF, 4);
+      value >>= 4;
+   } while (stream->writeFlag(value != 0));
+}
+
+static U32 readNetInt(BitStream* stream)
+{
+   U32 value = 0;
+   U32 shift = 0;
+
+   do
+   {
+      value |= U32(stream->readInt(4)) << shift;
+      shift += 4;
+   } while (stream->readFlag() && shift < 32);
+
+   return value;
+}
+
+// Rotations go out as the three smallest quat components, plus which one was dropped. The dropped one is
+// rebuilt from the unit length, and since q and -q are the same rotation we can always make it positive
+static void writeRotation(BitStream* stream, QuatF quat)
+{
+   quat.normalize();
+
+   F32 comps[4] = { quat.x, quat.y, quat.z, quat.w };
+
+   U32 largest = 0;
+   for (U32 i = 1; i < 4; i++)
+   {
+      if (mFabs(comps[i]) > mFabs(comps[largest]))
+         largest = i;
+   }
+
+   const F32 sign = (comps[largest] < 0.0f) ? -1.0f : 1.0f;
+
+   stream->writeInt(largest, 2);
+
+   for (U32 i = 0; i < 4; i++)
+   {
+      if (i != largest)
+         stream->writeSignedFloat(mClampF(comps[i] * sign * sQuatComponentScale, -1.0f, 1.0f), sQuatComponentBits);
+   }
+}
+
+static void readRotation(BitStream* stream, QuatF* quat)
+{
+   const U32 largest = stream->readInt(2);
+
+   F32 comps[4];
+   F32 sumSq = 0.0f;
+
+   for (U32 i = 0; i < 4; i++)
+   {
+      if (i == largest)
+         continue;
+
+      comps[i] = stream->readSignedFloat(sQuatComponentBits) / sQuatComponentScale;
+      sumSq += comps[i] * comps[i];
+   }
+
+   comps[largest] = mSqrt(getMax(0.0f, 1.0f - sumSq));
+
+   quat->set(comps[0], comps[1], comps[2], comps[3]);
+   quat->normalize();
+}
+
+static bool movesDiffer(const Move& a, const Move& b)
+{
+   if (a.x != b.x || a.y != b.y || a.z != b.z ||
+      a.yaw != b.yaw || a.pitch != b.pitch || a.roll != b.roll ||
+      a.freeLook != b.freeLook)
+      return true;
+
+   for (U32 i = 0; i < MaxTriggerKeys; i++)
+   {
+      if (a.trigger[i] != b.trigger[i])
+         return true;
+   }
+
+   return false;
+}
+
+// Networked components are sent by net class id where they have one, the same way ghosts are. Classes that
+// aren't in the connection's net class table (script-only or non-net classes) fall back to their name
+static S32 getComponentNetClassId(Component* comp, U32 classGroup)
+{
+   AbstractClassRep* rep = comp->getClassRep();
+
+   if (rep->mClassType != NetClassTypeObject || !(rep->mClassGroupMask & (1 << classGroup)))
+      return -1;
+
+   return rep->getClassId(classGroup);
+}
+
 
 IMPLEMENT_CO_NETOBJECT_V1(Entity);
 
@@ -112,7 +250,7 @@ Entity::Entity()
    mNetFlags.set(Ghostable | ScopeAlways);
 
    mPos = Point3F(0, 0, 0);
-   mRot = Point3F(0, 0, 0);
+   assignRotation(Point3F(0, 0, 0));
 
    mDelta.pos = mDelta.posVec = Point3F::Zero;
    mDelta.rot[0].identity();
@@ -123,13 +261,35 @@ Entity::Entity()
    mDelta.dt = 1.0f;
    mDelta.move = NullMove;
 
+   mNetPos = Point3F::Zero;
+   mNetRotQuat.identity();
+
+   mKeyframePos = Point3F::Zero;
+   mKeyframeSeq = -1;
+
    mComponents.clear();
 
+   mComponentTypeMask = 0;
+   mQueryIndex = -1;
+   mInterpolationIndex = -1;
+
+   mMountedTransform.identity();
+   mMountedTransformDirty = true;
+
    mStartComponentUpdate = false;
 
    mInitialized = false;
 
    mLifetimeMS = 0;
+   mLifetimeTimer = NULL;
+   mStartTick = 0;
+
+   mDormant = false;
+   mIdleTicks = 0;
+
+   mScriptCallbackMask = 0;
+   mScriptCallbackNamespace = NULL;
+   mScriptCallbackSequence = 0;
 
    mGameObjectAssetId = StringTable->insert("");
 
@@ -141,6 +301,26 @@ Entity::~Entity()
 
 }
 
+void Entity::consoleInit()
+{
+   Con::addVariable("$Entity::componentTickThreads", TypeS32, &ComponentTickScheduler::smWorkerThreadCount,
+      "@brief Number of worker threads used to tick thread-safe component types on the server.\n\n"
+      "0 ticks every component on the main thread.\n"
+      "@ingroup Entity\n");
+   Con::addVariable("$Entity::minParallelComponentBatch", TypeS32, &ComponentTickScheduler::smMinParallelBatchSize,
+      "@brief Smallest batch of same-type components that will be split across the worker threads.\n\n"
+      "@ingroup Entity\n");
+   Con::addVariable("$Entity::dormantTickThreshold", TypeS32, &Entity::smDormantTickThreshold,
+      "@brief Number of consecutive idle ticks before a server entity stops ticking until something wakes it.\n\n"
+      "0 disables dormancy.\n"
+      "@ingroup Entity\n");
+   Con::addVariable("$Entity::componentUpdateBudget", TypeS32, &Entity::smComponentUpdateBudget,
+      "@brief Bits of component updates an entity packs into a single update for a connection.\n\n"
+      "Components are packed highest priority first. Whatever doesn't fit goes out in a later update, "
+      "and the highest priority component is always sent. 0 removes the limit.\n"
+      "@ingroup Entity\n");
+}
+
 void Entity::initPersistFields()
 {
    Parent::initPersistFields();
@@ -163,6 +343,8 @@ void Entity::initPersistFields()
 
    addGroup("Misc");
    addField("LifetimeMS", TypeS32, Offset(mLifetimeMS, Entity), "Object world orientation.");
+   addProtectedField("Tags", TypeRealString, Offset(mTags, Entity), &_setTags, &defaultProtectedGetFn, 
+      "Space separated list of tags, for looking the entity up with findEntitiesByTag().");
    endGroup("Misc");
 
    addGroup("GameObject");
@@ -253,8 +435,15 @@ bool Entity::onAdd()
    //Make sure we get positioned
    if (isServerObject())
    {
-      setMaskBits(TransformMask);
+      mKeyframePos = mPos;
+      mKeyframeSeq = 0;
+
+      setMaskBits(TransformMask | TransformKeyframeMask);
       //setMaskBits(NamespaceMask);
+
+      //anything added before we were will be waiting to be scheduled
+      for (U32 i = 0; i < mComponents.size(); i++)
+         ComponentTickScheduler::getServer()->registerComponent(mComponents[i]);
    }
    else
    {
@@ -262,15 +451,36 @@ bool Entity::onAdd()
       onPostAdd();
    }
 
+   if (isServerObject())
+   {
+      indexTags();
+      EntityQuery::trackEntity(this);
+   }
+   else
+   {
+      EntityInterpolationBatch::getClient()->addEntity(this);
+   }
+
+   mStartTick = getTimerWheel()->getCurrentTick();
+
    if (mLifetimeMS != 0)
-      mStartTimeMS = Platform::getRealMilliseconds();
+      scheduleLifetime();
 
    return true;
 }
 
 void Entity::onRemove()
 {
+   cancelLifetime();
+
+   unindexTags();
+   EntityQuery::untrackEntity(this);
+   EntityInterpolationBatch::getClient()->removeEntity(this);
+
    clearComponents(true);
+   clearNetSlots();
+
+   clearEventListeners();
 
    removeFromScene();
 
@@ -291,31 +501,38 @@ void Entity::onPostAdd()
       mComponents[i]->onComponentAdd();
    }
 
-   //Set up the networked components
-   mNetworkedComponents.clear();
-   for (U32 i = 0; i < mComponents.size(); i++)
+   //Set up the networked components. Ghosts already got theirs, slots and all, from the server
+   if (isServerObject())
    {
-      if (mComponents[i]->isNetworked())
-      {
-         NetworkedComponent netComp;
-         netComp.componentIndex = i;
-         netComp.updateState = NetworkedComponent::Adding;
-         netComp.updateMaskBits = -1;
+      clearNetSlots();
 
-         mNetworkedComponents.push_back(netComp);
+      for (U32 i = 0; i < mComponents.size(); i++)
+      {
+         if (mComponents[i]->isNetworked())
+            addNetworkedComponent(mComponents[i]);
       }
-   }
 
-   if (!mNetworkedComponents.empty())
-   {
-      setMaskBits(AddComponentsMask);
-      setMaskBits(ComponentsUpdateMask);
+      if (!mNetworkedComponents.empty())
+      {
+         setMaskBits(AddComponentsMask);
+         setMaskBits(ComponentsUpdateMask);
+      }
    }
 
    if (isMethod("onAdd"))
       Con::executef(this, "onAdd");
 }
 
+bool Entity::_setTags(void *object, const char *index, const char *data)
+{
+   Entity* ent = static_cast<Entity*>(object);
+   if (ent)
+      ent->setTags(data);
+
+   // setTags keeps mTags up to date itself
+   return false;
+}
+
 bool Entity::_setGameObject(void *object, const char *index, const char *data)
 {
    // Sanity!
@@ -328,6 +545,8 @@ void Entity::setDataField(StringTableEntry slotName, const char *array, const ch
 {
    Parent::setDataField(slotName, array, value);
 
+   wakeUp();
+
    onDataSet.trigger(this, slotName, value);
 }
 
@@ -335,15 +554,32 @@ void Entity::onStaticModified(const char* slotName, const char* newValue)
 {
    Parent::onStaticModified(slotName, newValue);
 
+   if (!dStricmp(slotName, "LocalPosition") || !dStricmp(slotName, "LocalRotation"))
+      markMountedTransformDirty();
+
+   //lifetime still counts from when we were added, so just reschedule with the new length
+   if (isProperlyAdded() && !dStricmp(slotName, "LifetimeMS"))
+   {
+      cancelLifetime();
+
+      if (mLifetimeMS != 0)
+         scheduleLifetime();
+   }
+
    onDataSet.trigger(this, slotName, newValue);
 }
 
 //Updating
 void Entity::processTick(const Move* move)
 {
-   for (U32 i = 0; i < mComponents.size(); i++)
+   //On the server, components have already been ticked in per-type batches by the scheduler, ahead of
+   //every entity's own step. See ComponentTickScheduler for the phase order
+   if (isClientObject())
    {
-      mComponents[i]->processTick();
+      for (U32 i = 0; i < mTickComponents.size(); i++)
+      {
+         mTickComponents[i]->processTick();
+      }
    }
 
    if (!isHidden())
@@ -363,13 +599,18 @@ void Entity::processTick(const Move* move)
          mDelta.posVec.x = -mDelta.warpOffset.x;
          mDelta.posVec.y = -mDelta.warpOffset.y;
          mDelta.posVec.z = -mDelta.warpOffset.z;
+
+         EntityInterpolationBatch::getClient()->updateEntity(this);
       }
       else
       {
          if (isMounted())
          {
-            MatrixF mat;
-            mMount.object->getMountTransform(mMount.node, mMount.xfm, &mat);
+            //Whatever we're mounted to has already ticked, so this is where the mount chain gets
+            //evaluated, once for the tick. Anything mounted to us ticks after us and picks it up
+            markMountedTransformDirty();
+
+            const MatrixF& mat = getMountedTransform();
             Parent::setTransform(mat);
             Parent::setRenderTransform(mat);
          }
@@ -403,37 +644,46 @@ void Entity::processTick(const Move* move)
 
       if (move && isServerObject())
       {
+         onMoveEvent.trigger(*move, prevMove);
+
+         //clients predict with the last move we sent them, so only resend it when it changes
+         if (movesDiffer(*move, mDelta.move))
+         {
+            mDelta.move = *move;
+            setMaskBits(MoveMask);
+         }
+
          if ((move->y != 0 || prevMove.y != 0) 
             || (move->x != 0 || prevMove.x != 0) 
             || (move->z != 0 || prevMove.x != 0))
          {
-            if (isMethod("moveVectorEvent"))
+            if (hasScriptCallback(MoveVectorCallback))
                Con::executef(this, "moveVectorEvent", move->x, move->y, move->z);
          }
 
          if (move->yaw != 0)
          {
-            if (isMethod("moveYawEvent"))
+            if (hasScriptCallback(MoveYawCallback))
                Con::executef(this, "moveYawEvent", move->yaw);
          }
 
          if (move->pitch != 0)
          {
-            if (isMethod("movePitchEvent"))
+            if (hasScriptCallback(MovePitchCallback))
                Con::executef(this, "movePitchEvent", move->pitch);
          }
 
          if (move->roll != 0)
          {
-            if (isMethod("moveRollEvent"))
+            if (hasScriptCallback(MoveRollCallback))
                Con::executef(this, "moveRollEvent", move->roll);
          }
 
-         for (U32 i = 0; i < MaxTriggerKeys; i++)
+         if (hasScriptCallback(MoveTriggerCallback))
          {
-            if (move->trigger[i] != prevMove.trigger[i])
+            for (U32 i = 0; i < MaxTriggerKeys; i++)
             {
-               if (isMethod("moveTriggerEvent"))
+               if (move->trigger[i] != prevMove.trigger[i])
                   Con::executef(this, "moveTriggerEvent", i, move->trigger[i]);
             }
          }
@@ -441,35 +691,152 @@ void Entity::processTick(const Move* move)
 
       // Save current rigid state interpolation
       mDelta.posVec = getPosition();
-      mDelta.rot[0] = mRot.asQuatF();
+      mDelta.rot[0] = mRotQuat;
 
       //Handle any script updates, which can include physics stuff
-      if (isServerObject() && isMethod("processTick"))
+      if (isServerObject() && hasScriptCallback(ProcessTickCallback))
          Con::executef(this, "processTick");
 
       // Wrap up interpolation info
       mDelta.pos = getPosition();
       mDelta.posVec -= getPosition();
-      mDelta.rot[1] = mRot.asQuatF();
+      mDelta.rot[1] = mRotQuat;
 
       setTransform(getPosition(), mRot);
 
-      //Lifetime test
-      if (mLifetimeMS != 0)
-      {
-         S32 currentTime = Platform::getRealMilliseconds();
-         if (currentTime - mStartTimeMS >= mLifetimeMS)
-            deleteObject();
-      }
+      if (isServerObject())
+         updateDormancy();
+      else
+         EntityInterpolationBatch::getClient()->updateEntity(this);
    }
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool Entity::hasScriptCallback(U32 callback)
+{
+   //Namespace::mCacheSequence is bumped whenever namespaces are relinked or functions are (re)defined
+   if (getNamespace() != mScriptCallbackNamespace || Namespace::mCacheSequence != mScriptCallbackSequence)
+      refreshScriptCallbacks();
+
+   return (mScriptCallbackMask & callback) != 0;
+}
+
+void Entity::refreshScriptCallbacks()
+{
+   static const struct
+   {
+      U32 callback;
+      const char* name;
+   } sCallbackNames[] =
+   {
+      { MoveVectorCallback, "moveVectorEvent" },
+      { MoveYawCallback, "moveYawEvent" },
+      { MovePitchCallback, "movePitchEvent" },
+      { MoveRollCallback, "moveRollEvent" },
+      { MoveTriggerCallback, "moveTriggerEvent" },
+      { ProcessTickCallback, "processTick" },
+      { CollisionEventCallback, "onCollisionEvent" }
+   };
+
+   mScriptCallbackMask = 0;
+
+   for (U32 i = 0; i < sizeof(sCallbackNames) / sizeof(sCallbackNames[0]); i++)
+   {
+      if (isMethod(sCallbackNames[i].name))
+         mScriptCallbackMask |= sCallbackNames[i].callback;
+   }
+
+   mScriptCallbackNamespace = getNamespace();
+   mScriptCallbackSequence = Namespace::mCacheSequence;
+}
+
+//////////////////////////////////////////////////////////////////////////
+EntityTimerWheel* Entity::getTimerWheel()
+{
+   return isServerObject() ? EntityTimerWheel::getServer() : EntityTimerWheel::getClient();
+}
+
+void Entity::scheduleLifetime()
+{
+   EntityTimerWheel* wheel = getTimerWheel();
+
+   //lifetimes are in ms, but the wheel runs on sim ticks
+   U32 lifetimeTicks = 1;
+   if (mLifetimeMS > 0)
+      lifetimeTicks = (mLifetimeMS + TickMs - 1) / TickMs;
+
+   U32 elapsedTicks = wheel->getCurrentTick() - mStartTick;
+   U32 remainingTicks = lifetimeTicks > elapsedTicks ? lifetimeTicks - elapsedTicks : 1;
+
+   mLifetimeTimer = wheel->schedule(this, remainingTicks);
+}
+
+void Entity::cancelLifetime()
+{
+   if (mLifetimeTimer == NULL)
+      return;
+
+   getTimerWheel()->cancel(mLifetimeTimer);
+   mLifetimeTimer = NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//An entity is idle for a tick if nothing moved it, nobody is driving it and neither script nor any of
+//its components have work to do. After enough idle ticks in a row we stop ticking it entirely.
+void Entity::updateDormancy()
+{
+   if (smDormantTickThreshold <= 0)
+      return;
+
+   bool idle = !isMounted() &&
+      getControllingClient() == NULL &&
+      mDelta.warpCount >= mDelta.warpTicks &&
+      mDelta.posVec.isZero() &&
+      mDelta.rot[0] == mDelta.rot[1] &&
+      !hasScriptCallback(ProcessTickCallback);
+
+   for (U32 i = 0; idle && i < mComponents.size(); i++)
+   {
+      if (!mComponents[i]->isIdle())
+         idle = false;
+   }
+
+   if (!idle)
+   {
+      mIdleTicks = 0;
+      return;
+   }
+
+   if (++mIdleTicks >= (U32)smDormantTickThreshold)
+   {
+      mDormant = true;
+      setProcessTick(false);
+   }
+}
+
+void Entity::wakeUp()
+{
+   if (!mDormant)
+      return;
+
+   mDormant = false;
+   mIdleTicks = 0;
+   setProcessTick(true);
+}
+
 void Entity::advanceTime(F32 dt)
 {
 }
 
 void Entity::interpolateTick(F32 dt)
 {
+   //Ghosts are interpolated together, by whichever of them gets here first this frame
+   if (mInterpolationIndex != -1)
+   {
+      EntityInterpolationBatch::getClient()->interpolate(dt);
+      return;
+   }
+
    if (dt == 0.0f)
    {
       setRenderTransform(mDelta.pos, mDelta.rot[1]);
@@ -498,12 +865,49 @@ U32 Entity::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
 
    if (stream->writeFlag(mask & TransformMask))
    {
-      stream->writeCompressedPoint(mPos);
-      mathWrite(*stream, getRotation());
+      //Keyframes go out in full. A dropped one gets its mask bit back, so it's resent until it lands
+      if (stream->writeFlag(mask & TransformKeyframeMask))
+      {
+         stream->writeInt(mKeyframeSeq, sKeyframeSeqBits);
+         mathWrite(*stream, mKeyframePos);
+      }
 
-      mDelta.move.pack(stream);
+      //Otherwise we only send how far we are from the keyframe, tagged with which keyframe that is
+      Point3F offset = (mPos - mKeyframePos) * sPositionDeltaScale;
+      const F32 maxOffset = F32(1 << (sPositionDeltaBits - 1)) - 1.0f;
+
+      if (stream->writeFlag(mFabs(offset.x) < maxOffset && mFabs(offset.y) < maxOffset && mFabs(offset.z) < maxOffset))
+      {
+         stream->writeInt(mKeyframeSeq, sKeyframeSeqBits);
+         stream->writeSignedInt((S32)mRound(offset.x), sPositionDeltaBits);
+         stream->writeSignedInt((S32)mRound(offset.y), sPositionDeltaBits);
+         stream->writeSignedInt((S32)mRound(offset.z), sPositionDeltaBits);
+      }
+      else
+      {
+         mathWrite(*stream, mPos);
+      }
+
+      writeRotation(stream, mRotQuat);
 
       stream->writeFlag(!(mask & NoWarpMask));
+
+      mNetPos = mPos;
+      mNetRotQuat = mRotQuat;
+   }
+
+   //The move can change while we stand still, so it doesn't ride along with the transform.
+   //Only the controlling client predicts with it, everyone else gets a NullMove as before
+   if (stream->writeFlag(mask & MoveMask))
+   {
+      GameConnection* gameCon = dynamic_cast<GameConnection*>(con);
+      if (gameCon && gameCon->getControlObject() == this)
+         mDelta.move.pack(stream);
+      else
+      {
+         Move nullMove = NullMove;
+         nullMove.pack(stream);
+      }
    }
 
    if (stream->writeFlag(mask & BoundsMask))
@@ -511,104 +915,113 @@ U32 Entity::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
       mathWrite(*stream, mObjBox);
    }
 
-   if (stream->writeFlag(mask & AddComponentsMask))
-   {
-      U32 toAddComponentCount = 0;
+   GhostComponentState* ghostState = NULL;
 
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
-      {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Adding)
-         {
-            toAddComponentCount++;
-         }
-      }
+   if (mask & (AddComponentsMask | RemoveComponentsMask | ComponentsUpdateMask))
+      ghostState = getGhostComponentState(con);
 
-      //you reaaaaally shouldn't have >255 networked components on a single entity
-      stream->writeInt(toAddComponentCount, 8);
+   //Adds and removals both go out as the whole slot map, which the client reconciles against what it has
+   if (stream->writeFlag(mask & (AddComponentsMask | RemoveComponentsMask)))
+   {
+      writeNetInt(stream, mNetworkedComponents.size());
 
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
+      const U32 classGroup = con->getNetClassGroup();
+
+      for (U32 netSlot = 0; netSlot < mNetworkedComponents.size(); netSlot++)
       {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Adding)
-         {
-            const char* className = mComponents[mNetworkedComponents[i].componentIndex]->getClassName();
-            stream->writeString(className, strlen(className));
+         const NetworkedComponent& netComp = mNetworkedComponents[netSlot];
 
-            mNetworkedComponents[i].updateState = NetworkedComponent::Updating;
-         }
-      }
-   }
+         if (!stream->writeFlag(netComp.component != NULL))
+            continue;
 
-   if (stream->writeFlag(mask & RemoveComponentsMask))
-   {
-      /*U32 toRemoveComponentCount = 0;
+         stream->writeInt(netComp.generation, sNetSlotGenerationBits);
 
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
-      {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Adding)
+         const S32 classId = getComponentNetClassId(netComp.component, classGroup);
+
+         if (stream->writeFlag(classId != -1))
          {
-            toRemoveComponentCount++;
+            stream->writeClassId(classId, NetClassTypeObject, classGroup);
          }
-      }
-
-      //you reaaaaally shouldn't have >255 networked components on a single entity
-      stream->writeInt(toRemoveComponentCount, 8);
-
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
-      {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Removing)
+         else
          {
-            stream->writeInt(i, 16);
+            const char* className = netComp.component->getClassName();
+            stream->writeString(className, strlen(className));
          }
-      }*/
 
-      /*for (U32 i = 0; i < mNetworkedComponents.size(); i++)
-      {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::UpdateState::Removing)
-         {
-            removeComponent(mComponents[mNetworkedComponents[i].componentIndex], true);
-            mNetworkedComponents.erase(i);
-            i--;
+         //this map may be what the ghost ends up creating it from, so it gets everything again
+         ghostState->setSlotMask(netSlot, -1);
+      }
 
-         }
-      }*/
+      mask |= ComponentsUpdateMask;
    }
 
-   //Update our components
+   //Update our components, most important to this connection first, until we've used up our budget
    if (stream->writeFlag(mask & ComponentsUpdateMask))
    {
-      U32 toUpdateComponentCount = 0;
+      const F32 ownerPriority = getComponentUpdatePriority(con);
+
+      //Only slots with something pending for this connection get looked at
+      Vector<U32> dirtySlots;
+      dirtySlots.reserve(ghostState->dirtyCount);
+      ghostState->getDirtySlots(dirtySlots);
+
+      Vector<ComponentUpdateOrder> updateOrder;
+      updateOrder.setSize(dirtySlots.size());
 
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
+      for (U32 i = 0; i < dirtySlots.size(); i++)
       {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Updating)
-         {
-            toUpdateComponentCount++;
-         }
+         updateOrder[i].netSlot = dirtySlots[i];
+         updateOrder[i].priority = mNetworkedComponents[dirtySlots[i]].component->getNetUpdatePriority(con, ownerPriority);
       }
 
-      //you reaaaaally shouldn't have >255 networked components on a single entity
-      stream->writeInt(toUpdateComponentCount, 8);
+      if (updateOrder.size() > 1)
+         dQsort(updateOrder.address(), updateOrder.size(), sizeof(ComponentUpdateOrder), compareComponentUpdateOrder);
 
       bool forceUpdate = false;
+      const U32 startBit = stream->getBitPosition();
 
-      for (U32 i = 0; i < mNetworkedComponents.size(); i++)
+      //Flag-terminated rather than counted, as we don't know up front how many will fit
+      for (U32 i = 0; i < updateOrder.size(); i++)
       {
-         if (mNetworkedComponents[i].updateState == NetworkedComponent::Updating)
+         if (i > 0 && smComponentUpdateBudget > 0 && stream->getBitPosition() - startBit >= (U32)smComponentUpdateBudget)
          {
-            stream->writeInt(i, 8);
+            //the rest wait for the next update
+            forceUpdate = true;
+            break;
+         }
 
-            mNetworkedComponents[i].updateMaskBits = mComponents[mNetworkedComponents[i].componentIndex]->packUpdate(con, mNetworkedComponents[i].updateMaskBits, stream);
+         const U32 netSlot = updateOrder[i].netSlot;
+         const NetworkedComponent& netComp = mNetworkedComponents[netSlot];
 
-            if (mNetworkedComponents[i].updateMaskBits != 0)
-               forceUpdate = true;
-            else
-               mNetworkedComponents[i].updateState = NetworkedComponent::None;
-         }
+         stream->writeFlag(true);
+         writeNetInt(stream, netSlot);
+         stream->writeInt(netComp.generation, sNetSlotGenerationBits);
+
+         //Length prefixed, so a client that doesn't have this component (yet) can step over it
+         const U32 lengthBit = stream->getBitPosition();
+         stream->writeInt(0, sComponentUpdateLengthBits);
+
+         const U32 updateStartBit = stream->getBitPosition();
+         const U32 leftoverMask = netComp.component->packUpdate(con, ghostState->slotMasks[netSlot], stream);
+         const U32 updateEndBit = stream->getBitPosition();
+
+         AssertFatal(updateEndBit - updateStartBit < BIT(sComponentUpdateLengthBits), "Entity::packUpdate() - Component update too long for its length prefix.");
+
+         stream->setBitPosition(lengthBit);
+         stream->writeInt(updateEndBit - updateStartBit, sComponentUpdateLengthBits);
+         stream->setBitPosition(updateEndBit);
+
+         ghostState->setSlotMask(netSlot, leftoverMask);
+
+         if (leftoverMask != 0)
+            forceUpdate = true;
       }
 
-      //If we have leftover, we need to re-iterate our packing
+      stream->writeFlag(false);
+
+      //If we have leftover, only this connection needs to come back for it
       if (forceUpdate)
-         setMaskBits(ComponentsUpdateMask);
+         retMask |= ComponentsUpdateMask;
    }
 
    /*if (stream->writeFlag(mask & NamespaceMask))
@@ -633,15 +1046,42 @@ void Entity::unpackUpdate(NetConnection *con, BitStream *stream)
 
    if (stream->readFlag())
    {
+      if (stream->readFlag())
+      {
+         mKeyframeSeq = stream->readInt(sKeyframeSeqBits);
+         mathRead(*stream, &mKeyframePos);
+      }
+
       Point3F pos;
-      stream->readCompressedPoint(&pos);
 
-      RotationF rot;
-      mathRead(*stream, &rot);
+      if (stream->readFlag())
+      {
+         const S32 keyframeSeq = stream->readInt(sKeyframeSeqBits);
 
-      mDelta.move.unpack(stream);
+         Point3F offset;
+         offset.x = stream->readSignedInt(sPositionDeltaBits);
+         offset.y = stream->readSignedInt(sPositionDeltaBits);
+         offset.z = stream->readSignedInt(sPositionDeltaBits);
+
+         //relative to a keyframe we haven't got yet. The server's still resending it, so hold where we are,
+         //but the rotation is absolute and still good
+         if (keyframeSeq == mKeyframeSeq)
+            pos = mKeyframePos + offset / sPositionDeltaScale;
+         else
+            pos = mDelta.pos + mDelta.posVec * mDelta.dt;
+      }
+      else
+      {
+         mathRead(*stream, &pos);
+      }
 
-      if (stream->readFlag() && isProperlyAdded())
+      QuatF rotQuat;
+      readRotation(stream, &rotQuat);
+      RotationF rot(rotQuat);
+
+      const bool warp = stream->readFlag();
+
+      if (warp && isProperlyAdded())
       {
          // Determine number of ticks to warp based on the average
          // of the client and server velocities.
@@ -694,57 +1134,107 @@ void Entity::unpackUpdate(NetConnection *con, BitStream *stream)
          mDelta.warpCount = mDelta.warpTicks = 0;
          setTransform(pos, rot);
       }
+
+      EntityInterpolationBatch::getClient()->updateEntity(this);
    }
 
+   if (stream->readFlag())
+      mDelta.move.unpack(stream);
+
    if (stream->readFlag())
    {
       mathRead(*stream, &mObjBox);
       resetWorldBox();
    }
 
-   //AddComponentMask
+   //Slot map, for whenever components were added or removed
    if (stream->readFlag())
    {
-      U32 addedComponentCount = stream->readInt(8);
+      const U32 slotCount = readNetInt(stream);
+
+      const U32 classGroup = con->getNetClassGroup();
 
-      for (U32 i = 0; i < addedComponentCount; i++)
+      for (U32 netSlot = 0; netSlot < slotCount; netSlot++)
       {
+         if (!stream->readFlag())
+         {
+            if (netSlot < mNetworkedComponents.size() && mNetworkedComponents[netSlot].component != NULL)
+               setGhostNetSlot(netSlot, 0, NULL);
+
+            continue;
+         }
+
+         const U8 generation = stream->readInt(sNetSlotGenerationBits);
+
+         S32 classId = -1;
          char className[256] = "";
-         stream->readString(className);
 
-         //Change to components, so iterate our list and create any new components
-         // Well, looks like we have to create a new object.
-         const char* componentType = className;
+         if (stream->readFlag())
+            classId = stream->readClassId(NetClassTypeObject, classGroup);
+         else
+            stream->readString(className);
+
+         //Already got this one, from an earlier copy of the map
+         if (netSlot < mNetworkedComponents.size() && mNetworkedComponents[netSlot].component != NULL &&
+            mNetworkedComponents[netSlot].generation == generation)
+            continue;
 
-         ConsoleObject *object = ConsoleObject::create(componentType);
+         ConsoleObject *object = NULL;
+
+         if (classId != -1)
+            object = ConsoleObject::create(classGroup, NetClassTypeObject, classId);
+         else if (className[0])
+            object = ConsoleObject::create(className);
 
-         // Finally, set currentNewObject to point to the new one.
          Component* newComponent = dynamic_cast<Component *>(object);
 
-         if (newComponent)
+         if (!newComponent)
+         {
+            delete object;
+            newComponent = NULL;
+         }
+         //registered like any other ghost, so it can be removed and deleted like any other component
+         else if (!newComponent->registerObject())
          {
-            addComponent(newComponent);
+            Con::errorf("Entity::unpackUpdate() - Failed to register networked component %s on entity %i", newComponent->getClassName(), getId());
+            delete newComponent;
+            newComponent = NULL;
          }
+
+         //Whatever we had in the slot before is gone. If the new one failed, its updates get skipped
+         setGhostNetSlot(netSlot, generation, newComponent);
       }
-   }
 
-   //RemoveComponentMask
-   if (stream->readFlag())
-   {
-      
+      //and anything past the end of the map
+      for (U32 netSlot = slotCount; netSlot < mNetworkedComponents.size(); netSlot++)
+      {
+         if (mNetworkedComponents[netSlot].component != NULL)
+            setGhostNetSlot(netSlot, 0, NULL);
+      }
    }
 
    //ComponentUpdateMask
    if (stream->readFlag())
    {
-      U32 updatingComponents = stream->readInt(8);
-
-      for (U32 i = 0; i < updatingComponents; i++)
+      while (stream->readFlag())
       {
-         U32 updateComponentIndex = stream->readInt(8);
+         const U32 netSlot = readNetInt(stream);
+         const U8 generation = stream->readInt(sNetSlotGenerationBits);
+         const U32 updateLength = stream->readInt(sComponentUpdateLengthBits);
+         const U32 updateEndBit = stream->getBitPosition() + updateLength;
+
+         //Not one we have, most likely because the map that adds it was dropped and is on its way again
+         if (netSlot < mNetworkedComponents.size() && mNetworkedComponents[netSlot].component != NULL &&
+            mNetworkedComponents[netSlot].generation == generation)
+         {
+            mNetworkedComponents[netSlot].component->unpackUpdate(con, stream);
+
+            if (stream->getBitPosition() != updateEndBit)
+               Con::errorf("Entity::unpackUpdate() - %s read %i bits of a %i bit update on entity %i", mNetworkedComponents[netSlot].component->getClassName(),
+                  stream->getBitPosition() + updateLength - updateEndBit, updateLength, getId());
+         }
 
-         Component* comp = mComponents[updateComponentIndex];
-         comp->unpackUpdate(con, stream);
+         stream->setBitPosition(updateEndBit);
       }
    }
 
@@ -777,34 +1267,245 @@ void Entity::unpackUpdate(NetConnection *con, BitStream *stream)
 
 void Entity::setComponentNetMask(Component* comp, U32 mask)
 {
+   //a component changing networked state means it's doing something
+   wakeUp();
+
    setMaskBits(Entity::ComponentsUpdateMask);
 
-   for (U32 i = 0; i < mNetworkedComponents.size(); i++)
+   if (comp->mNetSlot == -1 || comp->mOwner != this)
+      return;
+
+   const U32 netSlot = comp->mNetSlot;
+
+   for (U32 i = 0; i < mGhostComponentStates.size(); i++)
+      mGhostComponentStates[i]->addSlotMask(netSlot, mask);
+}
+
+F32 Entity::getComponentUpdatePriority(NetConnection* con)
+{
+   GameConnection* gameCon = dynamic_cast<GameConnection*>(con);
+   if (!gameCon)
+      return 1.0f;
+
+   if (gameCon->getControlObject() == this)
+      return sControlledUpdatePriority;
+
+   MatrixF camTransform;
+   if (!gameCon->getControlCameraTransform(0.0f, &camTransform))
+      return 1.0f;
+
+   const F32 dist = (camTransform.getPosition() - getPosition()).len();
+
+   return 1.0f / (1.0f + dist * sUpdatePriorityFalloff);
+}
+
+Entity::GhostComponentState::GhostComponentState(NetConnection* con)
+{
+   connection = con;
+   dirtyCount = 0;
+}
+
+void Entity::GhostComponentState::addSlotMask(U32 netSlot, U32 mask)
+{
+   setSlotMask(netSlot, slotMasks[netSlot] | mask);
+}
+
+void Entity::GhostComponentState::setSlotMask(U32 netSlot, U32 mask)
+{
+   const bool wasDirty = slotMasks[netSlot] != 0;
+
+   slotMasks[netSlot] = mask;
+
+   if (mask != 0 && !wasDirty)
    {
-      U32 netCompId = mComponents[mNetworkedComponents[i].componentIndex]->getId();
-      U32 compId = comp->getId();
+      dirtySlots[netSlot >> 5] |= BIT(netSlot & 31);
+      dirtyCount++;
+   }
+   else if (mask == 0 && wasDirty)
+   {
+      dirtySlots[netSlot >> 5] &= ~BIT(netSlot & 31);
+      dirtyCount--;
+   }
+}
+
+void Entity::GhostComponentState::resize(U32 count)
+{
+   const U32 oldCount = slotMasks.size();
+
+   slotMasks.setSize(count);
+   for (U32 i = oldCount; i < count; i++)
+      slotMasks[i] = 0;
 
-      if (netCompId == compId && 
-         (mNetworkedComponents[i].updateState == NetworkedComponent::None || mNetworkedComponents[i].updateState == NetworkedComponent::Updating))
+   const U32 oldWords = dirtySlots.size();
+   const U32 words = (count + 31) >> 5;
+
+   if (words > oldWords)
+   {
+      dirtySlots.setSize(words);
+      for (U32 i = oldWords; i < words; i++)
+         dirtySlots[i] = 0;
+   }
+}
+
+void Entity::GhostComponentState::getDirtySlots(Vector<U32>& outSlots) const
+{
+   for (U32 word = 0; word < dirtySlots.size(); word++)
+   {
+      U32 bits = dirtySlots[word];
+
+      while (bits)
       {
-         mNetworkedComponents[i].updateState = NetworkedComponent::Updating;
-         mNetworkedComponents[i].updateMaskBits |= mask;
+         const U32 lowBit = bits & (~bits + 1);
+         outSlots.push_back((word << 5) + getBinLog2(lowBit));
+         bits &= ~lowBit;
+      }
+   }
+}
 
-         break;
+void Entity::addNetworkedComponent(Component* comp)
+{
+   U32 netSlot;
+
+   if (!mFreeNetSlots.empty())
+   {
+      netSlot = mFreeNetSlots.last();
+      mFreeNetSlots.pop_back();
+   }
+   else
+   {
+      netSlot = mNetworkedComponents.size();
+      resizeNetSlots(netSlot + 1);
+   }
+
+   NetworkedComponent& netComp = mNetworkedComponents[netSlot];
+   netComp.component = comp;
+   netComp.generation = (netComp.generation + 1) & ((1 << sNetSlotGenerationBits) - 1);
+
+   comp->mNetSlot = netSlot;
+}
+
+void Entity::removeNetworkedComponent(Component* comp)
+{
+   if (comp->mNetSlot == -1)
+      return;
+
+   const U32 netSlot = comp->mNetSlot;
+
+   comp->mNetSlot = -1;
+   mNetworkedComponents[netSlot].component = NULL;
+
+   //If we are the client, there's nobody to tell
+   if (!isServerObject())
+      return;
+
+   for (U32 i = 0; i < mGhostComponentStates.size(); i++)
+      mGhostComponentStates[i]->setSlotMask(netSlot, 0);
+
+   //The slot map carries the generation, so a ghost that hasn't heard about the removal yet still
+   //can't mistake whatever gets the slot next for the component it has
+   mFreeNetSlots.push_back(netSlot);
+
+   setMaskBits(RemoveComponentsMask);
+}
+
+Entity::GhostComponentState* Entity::getGhostComponentState(NetConnection* con)
+{
+   GhostComponentState* ghostState = NULL;
+
+   for (U32 i = 0; i < mGhostComponentStates.size();)
+   {
+      GhostComponentState* state = mGhostComponentStates[i];
+
+      //Connections that have gone away don't need telling anything anymore
+      if (state->connection.isNull())
+      {
+         delete state;
+         mGhostComponentStates.erase_fast(i);
+         continue;
       }
+
+      if (state->connection == con)
+         ghostState = state;
+
+      i++;
+   }
+
+   if (!ghostState)
+   {
+      ghostState = new GhostComponentState(con);
+      ghostState->resize(mNetworkedComponents.size());
+      mGhostComponentStates.push_back(ghostState);
+   }
+
+   return ghostState;
+}
+
+void Entity::setGhostNetSlot(U32 netSlot, U8 generation, Component* comp)
+{
+   if (netSlot >= mNetworkedComponents.size())
+      resizeNetSlots(netSlot + 1);
+
+   //removeComponent clears the slot for us
+   if (mNetworkedComponents[netSlot].component)
+      removeComponent(mNetworkedComponents[netSlot].component, true);
+
+   mNetworkedComponents[netSlot].generation = generation;
+
+   if (comp)
+   {
+      addComponent(comp);
+
+      mNetworkedComponents[netSlot].component = comp;
+      comp->mNetSlot = netSlot;
    }
 }
 
+void Entity::resizeNetSlots(U32 count)
+{
+   const U32 oldCount = mNetworkedComponents.size();
+
+   mNetworkedComponents.setSize(count);
+   for (U32 i = oldCount; i < count; i++)
+   {
+      mNetworkedComponents[i].component = NULL;
+      mNetworkedComponents[i].generation = 0;
+   }
+
+   for (U32 i = 0; i < mGhostComponentStates.size(); i++)
+      mGhostComponentStates[i]->resize(count);
+}
+
+void Entity::clearNetSlots()
+{
+   for (U32 i = 0; i < mNetworkedComponents.size(); i++)
+   {
+      if (mNetworkedComponents[i].component)
+         mNetworkedComponents[i].component->mNetSlot = -1;
+   }
+
+   mNetworkedComponents.clear();
+   mFreeNetSlots.clear();
+
+   for (U32 i = 0; i < mGhostComponentStates.size(); i++)
+      delete mGhostComponentStates[i];
+
+   mGhostComponentStates.clear();
+}
+
 //Manipulation
 void Entity::setTransform(const MatrixF &mat)
 {
-   MatrixF oldTransform = getTransform();
+   wakeUp();
 
    if (isMounted())
    {
+      MatrixF oldTransform = getTransform();
+
       // Use transform from mounted object
+      const MatrixF parentTransform = mMount.object->getTransform();
+
       Point3F newPos = mat.getPosition();
-      Point3F parentPos = mMount.object->getTransform().getPosition();
+      Point3F parentPos = parentTransform.getPosition();
 
       Point3F newOffset = newPos - parentPos;
 
@@ -817,19 +1518,21 @@ void Entity::setTransform(const MatrixF &mat)
 
       if (matEul != Point3F(0, 0, 0))
       {
-         Point3F mountEul = mMount.object->getTransform().toEuler();
+         Point3F mountEul = parentTransform.toEuler();
          Point3F diff = matEul - mountEul;
 
-         mRot = diff;
+         assignRotation(diff);
       }
       else
       {
-         mRot = Point3F(0, 0, 0);
+         assignRotation(Point3F(0, 0, 0));
       }
 
-      RotationF addRot = mRot + RotationF(mMount.object->getTransform());
+      RotationF addRot = mRot + RotationF(parentTransform);
       MatrixF transf = addRot.asMatrixF();
-      transf.setPosition(mPos + mMount.object->getPosition());
+      transf.setPosition(mPos + parentPos);
+
+      markMountedTransformDirty();
 
       Parent::setTransform(transf);
 
@@ -847,34 +1550,32 @@ void Entity::setTransform(const MatrixF &mat)
       }*/
       //else
       {
-         //mRot.set(mat);
-         //Parent::setTransform(mat);
+         //We already have the matrix, so use it as is rather than rebuilding it from a rotation
+         QuatF rotQuat(mat);
 
-         RotationF rot = RotationF(mat);
-
-         EulerF tempRot = rot.asEulerF(RotationF::Degrees);
-
-         Point3F pos;
-
-         mat.getColumn(3,&pos);
-
-         setTransform(pos, rot);
+         applyTransform(mat.getPosition(), RotationF(rotQuat), rotQuat, mat);
       }
    }
 }
 
 void Entity::setTransform(const Point3F& position, const RotationF& rotation)
 {
-   MatrixF oldTransform = getTransform();
+   wakeUp();
 
    if (isMounted())
    {
+      MatrixF oldTransform = getTransform();
+
       mPos = position;
-      mRot = rotation;
+      assignRotation(rotation);
+
+      const MatrixF parentTransform = mMount.object->getTransform();
 
-      RotationF addRot = mRot + RotationF(mMount.object->getTransform());
+      RotationF addRot = mRot + RotationF(parentTransform);
       MatrixF transf = addRot.asMatrixF();
-      transf.setPosition(mPos + mMount.object->getPosition());
+      transf.setPosition(mPos + parentTransform.getPosition());
+
+      markMountedTransformDirty();
 
       Parent::setTransform(transf);
 
@@ -883,53 +1584,89 @@ void Entity::setTransform(const Point3F& position, const RotationF& rotation)
    }
    else
    {
-      /*MatrixF newMat, imat, xmat, ymat, zmat;
-      Point3F radRot = Point3F(mDegToRad(rotation.x), mDegToRad(rotation.y), mDegToRad(rotation.z));
-      xmat.set(EulerF(radRot.x, 0, 0));
-      ymat.set(EulerF(0.0f, radRot.y, 0.0f));
-      zmat.set(EulerF(0, 0, radRot.z));
-      imat.mul(zmat, xmat);
-      newMat.mul(imat, ymat);*/
-
-      MatrixF newMat = rotation.asMatrixF();
+      //One conversion out of the rotation, and the matrix is built from the quaternion
+      QuatF rotQuat = rotation.asQuatF();
 
+      MatrixF newMat;
+      rotQuat.setMatrix(&newMat);
       newMat.setColumn(3, position);
 
-      mPos = position;
-      mRot = rotation;
+      applyTransform(position, rotation, rotQuat, newMat);
+   }
+}
 
-      //if (isServerObject())
-      //   setMaskBits(TransformMask);
+void Entity::applyTransform(const Point3F& position, const RotationF& rotation, const QuatF& rotQuat, const MatrixF& mat)
+{
+   //PROFILE_SCOPE(Entity_setTransform);
 
-      //setTransform(temp);
+   //Compare against what we last sent rather than what we last set, so motion too slow to notice from one
+   //call to the next still adds up to an update. q and -q are the same rotation, hence the absolute dot product
+   const bool changed = !mNetPos.equal(position) || mFabs(mNetRotQuat.dot(rotQuat)) < sRotationChangeEpsilon;
 
-      // This test is a bit expensive so turn it off in release.   
-#ifdef TORQUE_DEBUG
-      //AssertFatal( mat.isAffine(), "SceneObject::setTransform() - Bad transform (non affine)!" );
-#endif
+   mPos = position;
+   mRot = rotation;
+   mRotQuat = rotQuat;
 
-      //PROFILE_SCOPE(Entity_setTransform);
+   // Update the transforms.
+   Parent::setTransform(mat);
 
-      // Update the transforms.
-      Parent::setTransform(newMat);
+   //anything mounted to us has moved with us
+   markMountedTransformDirty();
 
-      U32 compCount = mComponents.size();
-      for (U32 i = 0; i < compCount; ++i)
-      {
-         mComponents[i]->ownerTransformSet(&newMat);
-      }
+   //setting the transform moves the render transform along with it, so both channels hear about it
+   MatrixF newMat = mat;
 
-      Point3F newPos = newMat.getPosition();
-      RotationF newRot = newMat;
+   for (U32 i = 0; i < mTransformListeners.size(); ++i)
+      mTransformListeners[i]->ownerTransformSet(&newMat);
 
-      Point3F oldPos = oldTransform.getPosition();
-      RotationF oldRot = oldTransform;
+   for (U32 i = 0; i < mRenderTransformListeners.size(); ++i)
+      mRenderTransformListeners[i]->ownerRenderTransformSet(&newMat);
 
-      if (newPos != oldPos || newRot != oldRot)
-         setMaskBits(TransformMask);
+   if (changed)
+   {
+      setMaskBits(TransformMask);
+
+      if (isServerObject())
+         updateTransformKeyframe();
    }
 }
 
+void Entity::updateTransformKeyframe()
+{
+   if ((mPos - mKeyframePos).lenSquared() < sKeyframeDistance * sKeyframeDistance)
+      return;
+
+   mKeyframePos = mPos;
+   mKeyframeSeq = (mKeyframeSeq + 1) & ((1 << sKeyframeSeqBits) - 1);
+
+   setMaskBits(TransformKeyframeMask);
+}
+
+void Entity::applyInterpolatedTransform(const Point3F& position, const QuatF& rotQuat, F32 dt)
+{
+   mDelta.dt = dt;
+
+   //Mounted render transforms are built off our mount, so let the usual path handle it
+   if (isMounted())
+   {
+      setRenderTransform(position, RotationF(rotQuat));
+      return;
+   }
+
+   MatrixF newMat;
+   rotQuat.setMatrix(&newMat);
+   newMat.setColumn(3, position);
+
+   mPos = position;
+   mRot = RotationF(rotQuat);
+   mRotQuat = rotQuat;
+
+   Parent::setRenderTransform(newMat);
+
+   for (U32 i = 0; i < mRenderTransformListeners.size(); ++i)
+      mRenderTransformListeners[i]->ownerRenderTransformSet(&newMat);
+}
+
 void Entity::setRenderTransform(const MatrixF &mat)
 {
    Parent::setRenderTransform(mat);
@@ -940,11 +1677,15 @@ void Entity::setRenderTransform(const Point3F& position, const RotationF& rotati
    if (isMounted())
    {
       mPos = position;
-      mRot = rotation;
+      assignRotation(rotation);
+
+      const MatrixF parentTransform = mMount.object->getTransform();
 
-      RotationF addRot = mRot + RotationF(mMount.object->getTransform());
+      RotationF addRot = mRot + RotationF(parentTransform);
       MatrixF transf = addRot.asMatrixF();
-      transf.setPosition(mPos + mMount.object->getPosition());
+      transf.setPosition(mPos + parentTransform.getPosition());
+
+      markMountedTransformDirty();
 
       Parent::setRenderTransform(transf);
    }
@@ -955,38 +1696,55 @@ void Entity::setRenderTransform(const Point3F& position, const RotationF& rotati
       newMat.setColumn(3, position);
 
       mPos = position;
-      mRot = rotation;
+      assignRotation(rotation);
 
       Parent::setRenderTransform(newMat);
 
-      U32 compCount = mComponents.size();
-      for (U32 i = 0; i < compCount; ++i)
-      {
-         mComponents[i]->ownerTransformSet(&newMat);
-      }
+      //render only, so interpolation every frame doesn't push transforms into physics reps
+      for (U32 i = 0; i < mRenderTransformListeners.size(); ++i)
+         mRenderTransformListeners[i]->ownerRenderTransformSet(&newMat);
    }
 }
 
 MatrixF Entity::getTransform()
 {
-   if (isMounted())
+   if (isMounted())
+      return getMountedTransform();
+   else
+      return Parent::getTransform();
+}
+
+const MatrixF& Entity::getMountedTransform()
+{
+   if (mMountedTransformDirty)
    {
-      MatrixF mat;
+      PROFILE_SCOPE(Entity_getMountedTransform);
 
       //Use transform from mount
-      mMount.object->getMountTransform(mMount.node, mMount.xfm, &mat);
+      mMount.object->getMountTransform(mMount.node, mMount.xfm, &mMountedTransform);
 
-      Point3F transPos = mat.getPosition() + mPos;
+      Point3F transPos = mMountedTransform.getPosition() + mPos;
 
-      mat.mul(mRot.asMatrixF());
+      mMountedTransform.mul(mRot.asMatrixF());
 
-      mat.setPosition(transPos);
+      mMountedTransform.setPosition(transPos);
 
-      return mat;
+      mMountedTransformDirty = false;
    }
-   else
+
+   return mMountedTransform;
+}
+
+void Entity::markMountedTransformDirty()
+{
+   mMountedTransformDirty = true;
+
+   //Our world transform feeds everything mounted to us, and theirs feeds anything mounted to them
+   for (U32 i = 0; i < getMountedObjectCount(); i++)
    {
-      return Parent::getTransform();
+      Entity* child = dynamic_cast<Entity*>(getMountedObject(i));
+      if (child)
+         child->markMountedTransformDirty();
    }
 }
 
@@ -996,6 +1754,7 @@ void Entity::setMountOffset(const Point3F& posOffset)
    {
       mMount.xfm.setColumn(3, posOffset);
       //mPos = posOffset;
+      markMountedTransformDirty();
       setMaskBits(MountedMask);
    }
 }
@@ -1018,28 +1777,27 @@ void Entity::setMountRotation(const EulerF& rotOffset)
 
       mMount.xfm = temp;
 
+      markMountedTransformDirty();
       setMaskBits(MountedMask);
    }
 }
 //
 void Entity::getCameraTransform(F32* pos, MatrixF* mat)
 {
-   Component* foundComp = getComponent(sCameraComponentType);
+   CameraComponent* cameraComp = getComponent<CameraComponent>();
 
-   if (foundComp != nullptr)
-   {
-      CameraComponent* cameraComp = static_cast<CameraComponent*>(foundComp);
+   if (cameraComp != nullptr)
       cameraComp->getCameraTransform(pos, mat);
-   }
 }
 
 void Entity::getMountTransform(S32 index, const MatrixF &xfm, MatrixF *outMat)
 {
-   renderComponent* renderComp = getComponent<renderComponent>(sRenderComponentType);
+   renderComponent* renderComp = getComponent<renderComponent>();
 
-   if (renderComp)
+   if (renderComp && renderComp->getShapeInstance())
    {
-      renderComp->getShapeInstance()->animate();
+      //only re-animates if the pose changed since the last query
+      renderComp->updateNodeTransforms();
       S32 nodeCount = renderComp->getShapeInstance()->getShape()->nodes.size();
 
       if (index >= 0 && index < nodeCount)
@@ -1065,11 +1823,11 @@ void Entity::getMountTransform(S32 index, const MatrixF &xfm, MatrixF *outMat)
 
 void Entity::getRenderMountTransform(F32 delta, S32 index, const MatrixF &xfm, MatrixF *outMat)
 {
-   renderComponent* renderComp = getComponent<renderComponent>(sRenderComponentType);
+   renderComponent* renderComp = getComponent<renderComponent>();
 
    if (renderComp && renderComp->getShapeInstance())
    {
-      renderComp->getShapeInstance()->animate();
+      renderComp->updateNodeTransforms();
       S32 nodeCount = renderComp->getShape()->nodes.size();
 
       if (index >= 0 && index < nodeCount)
@@ -1097,7 +1855,7 @@ void Entity::getRenderMountTransform(F32 delta, S32 index, const MatrixF &xfm, M
 //These basically just redirect to any collision behaviors we have
 bool Entity::castRay(const Point3F &start, const Point3F &end, RayInfo* info)
 {
-   CollisionComponent* collisionComp = getComponent<CollisionComponent>(sCollisionComponentType);
+   CollisionComponent* collisionComp = getComponent<CollisionComponent>();
 
    if (collisionComp != nullptr)
    {
@@ -1107,7 +1865,7 @@ bool Entity::castRay(const Point3F &start, const Point3F &end, RayInfo* info)
 
    return false;
 
-   /*renderComponent* renderComp = getComponent<renderComponent>(sRenderComponentType);
+   /*renderComponent* renderComp = getComponent<renderComponent>();
 
    if (renderComp != nullptr)
    {
@@ -1120,7 +1878,7 @@ bool Entity::castRay(const Point3F &start, const Point3F &end, RayInfo* info)
 
 bool Entity::castRayRendered(const Point3F &start, const Point3F &end, RayInfo *info)
 {
-   renderComponent* renderComp = getComponent<renderComponent>(sRenderComponentType);
+   renderComponent* renderComp = getComponent<renderComponent>();
 
    if (renderComp != nullptr)
    {
@@ -1145,13 +1903,10 @@ bool Entity::buildPolyList(PolyListContext context, AbstractPolyList* polyList,
 
 void Entity::buildConvex(const Box3F& box, Convex* convex)
 {
-   Component* foundComp = getComponent(sCollisionComponentType);
+   CollisionComponent* collComp = getComponent<CollisionComponent>();
 
-   if (foundComp != nullptr)
-   {
-      CollisionComponent* collComp = static_cast<CollisionComponent*>(foundComp);
+   if (collComp != nullptr)
       collComp->buildConvex(box, convex);
-   }
 }
 
 //
@@ -1169,6 +1924,10 @@ void Entity::mountObject(SceneObject *obj, S32 node, const MatrixF &xfm)
 
 void Entity::onMount(SceneObject *obj, S32 node)
 {
+   wakeUp();
+
+   markMountedTransformDirty();
+
    deleteNotify(obj);
 
    // Are we mounting to a GameBase object?
@@ -1187,6 +1946,10 @@ void Entity::onMount(SceneObject *obj, S32 node)
 
 void Entity::onUnmount(SceneObject *obj, S32 node)
 {
+   wakeUp();
+
+   markMountedTransformDirty();
+
    clearNotify(obj);
 
    Entity *entityObj = dynamic_cast<Entity*>(obj);
@@ -1204,6 +1967,8 @@ void Entity::onUnmount(SceneObject *obj, S32 node)
 
 void Entity::setControllingClient(GameConnection* client)
 {
+   wakeUp();
+
    if (isGhost() && gSFX3DWorld)
    {
       if (gSFX3DWorld->getListener() == this && !client && getControllingClient() && getControllingClient()->isConnectionToServer())
@@ -1245,7 +2010,7 @@ void Entity::addObject(SimObject* object)
       String node = e->getDataField("mountNode", NULL);
       if (!node.isEmpty())
       {
-         renderComponent* renderComp = getComponent<renderComponent>(sRenderComponentType);
+         renderComponent* renderComp = getComponent<renderComponent>();
          if (renderComp)
          {
             TSShape* shape = renderComp->getShape();
@@ -1305,7 +2070,7 @@ void Entity::removeObject(SimObject* object)
    if (e)
    {
       mPos = mPos + e->getPosition();
-      mRot = mRot + e->getRotation();
+      assignRotation(mRot + e->getRotation());
       unmountObject(e);
       setMaskBits(TransformMask);
    }
@@ -1324,28 +2089,39 @@ bool Entity::addComponent(Component *comp)
    if (comp == NULL)
       return false;
 
+   wakeUp();
+
    //double-check were not re-adding anything
    mComponents.push_back(comp);
 
+   indexComponentType(comp);
+   addComponentTypeSlots(comp);
+
+   if (comp->getUpdateHooks() & ComponentTypeRegistry::TickHook)
+      mTickComponents.push_back(comp);
+
+   addTransformListener(comp);
+
+   markEventHandlersDirty();
+
    // Register the component with this owner.
    comp->setOwner(this);
 
    comp->setIsServerObject(isServerObject());
 
+   if (isServerObject() && isProperlyAdded())
+      ComponentTickScheduler::getServer()->registerComponent(comp);
+
    //if we've already been added and this is being added after the fact(at runtime), 
    //then just go ahead and call it's onComponentAdd so it can get to work
    //if (mInitialized)
    {
       comp->onComponentAdd();
 
-      if (comp->isNetworked())
+      //ghosts get their networked components, and the slots for them, from the server
+      if (comp->isNetworked() && isServerObject())
       {
-         NetworkedComponent netComp;
-         netComp.componentIndex = mComponents.size() - 1;
-         netComp.updateState = NetworkedComponent::Adding;
-         netComp.updateMaskBits = -1;
-
-         mNetworkedComponents.push_back(netComp);
+         addNetworkedComponent(comp);
 
          setMaskBits(AddComponentsMask);
          setMaskBits(ComponentsUpdateMask);
@@ -1357,6 +2133,85 @@ bool Entity::addComponent(Component *comp)
    return true;
 }
 
+void Entity::addTransformListener(Component* comp)
+{
+   const U32 channels = comp->getTransformChannels();
+
+   if (channels & Component::WorldTransformChannel)
+      mTransformListeners.push_back(comp);
+
+   if (channels & Component::RenderTransformChannel)
+      mRenderTransformListeners.push_back(comp);
+}
+
+U32 Entity::addComponents(const Vector<Component*>& components)
+{
+   if (components.empty())
+      return 0;
+
+   wakeUp();
+
+   const U32 existingCount = mComponents.size();
+   mComponents.reserve(existingCount + components.size());
+
+   //First, insert everything, so the whole set is visible to each component when it initializes
+   for (U32 i = 0; i < components.size(); i++)
+   {
+      Component* comp = components[i];
+      if (comp == NULL || comp->getOwner() == this)
+         continue;
+
+      mComponents.push_back(comp);
+
+      indexComponentType(comp);
+      addComponentTypeSlots(comp);
+
+      if (comp->getUpdateHooks() & ComponentTypeRegistry::TickHook)
+         mTickComponents.push_back(comp);
+
+      addTransformListener(comp);
+
+      comp->setOwner(this);
+      comp->setIsServerObject(isServerObject());
+
+      if (isServerObject() && isProperlyAdded())
+         ComponentTickScheduler::getServer()->registerComponent(comp);
+   }
+
+   const U32 addedCount = mComponents.size() - existingCount;
+   if (addedCount == 0)
+      return 0;
+
+   markEventHandlersDirty();
+
+   //Then the wiring pass. If we haven't been added yet, onPostAdd initializes everyone and sets up networking
+   if (mInitialized)
+   {
+      bool networked = false;
+
+      for (U32 i = existingCount; i < mComponents.size(); i++)
+      {
+         Component* comp = mComponents[i];
+         comp->onComponentAdd();
+
+         if (comp->isNetworked() && isServerObject())
+         {
+            addNetworkedComponent(comp);
+            networked = true;
+         }
+      }
+
+      if (networked)
+         setMaskBits(AddComponentsMask | ComponentsUpdateMask);
+   }
+
+   //Only announce them once they're all wired up, so listeners see the complete set
+   for (U32 i = existingCount; i < mComponents.size(); i++)
+      onComponentAdded.trigger(mComponents[i]);
+
+   return addedCount;
+}
+
 SimObject* Entity::findObjectByInternalName(StringTableEntry internalName, bool searchChildren)
 {
    for (U32 i = 0; i < mComponents.size(); i++)
@@ -1377,11 +2232,25 @@ bool Entity::removeComponent(Component *comp, bool deleteComponent)
    if (comp == NULL)
       return false;
 
+   wakeUp();
+
    if(mComponents.remove(comp))
    {
       AssertFatal(comp->isProperlyAdded(), "Don't know how but a component is not registered w/ the sim");
 
-      //setComponentsDirty();
+      unindexComponentType(comp);
+      removeComponentTypeSlots(comp);
+
+      mTickComponents.remove(comp);
+
+      mTransformListeners.remove(comp);
+      mRenderTransformListeners.remove(comp);
+
+      markEventHandlersDirty();
+
+      ComponentTickScheduler::getServer()->unregisterComponent(comp);
+
+      removeNetworkedComponent(comp);
 
       onComponentRemoved.trigger(comp);
 
@@ -1417,15 +2286,37 @@ void Entity::clearComponents(bool deleteComponents)
       while (mComponents.size() > 0)
       {
          Component* comp = mComponents.last();
+         mComponents.pop_back();
 
          if (comp)
          {
+            //Take it out of every lookup before anything runs, so the components still to go never
+            //find one that's already been deleted
+            unindexComponentType(comp);
+
+            //hand its slots to whoever's left, so nothing holds a ref to it once it's gone
+            removeComponentTypeSlots(comp);
+
+            mTickComponents.remove(comp);
+
+            mTransformListeners.remove(comp);
+            mRenderTransformListeners.remove(comp);
+
+            markEventHandlersDirty();
+
+            ComponentTickScheduler::getServer()->unregisterComponent(comp);
+
+            removeNetworkedComponent(comp);
+
             comp->onComponentRemove(); //in case the behavior needs to do cleanup on the owner
 
             comp->deleteObject();
          }
-         mComponents.pop_back();
       }
+
+      mComponentTypeIndex.clear();
+
+      mComponentTypeSlots.clear();
    }
 }
 
@@ -1440,15 +2331,141 @@ Component *Entity::getComponent(const U32 index) const
 
 Component *Entity::getComponent(StringTableEntry componentType)
 {
+   ComponentTypeIndex::Iterator itr = mComponentTypeIndex.find(componentType);
+
+   if (itr != mComponentTypeIndex.end())
+      return itr->value;
+
+   return NULL;
+}
+
+U32 Entity::getComponents(const StringTableEntry* componentTypes, U32 typeCount, Component** outComponents)
+{
+   U32 foundCount = 0;
+
+   for (U32 i = 0; i < typeCount; i++)
+   {
+      outComponents[i] = getComponent(componentTypes[i]);
+
+      if (outComponents[i] != NULL)
+         foundCount++;
+   }
+
+   return foundCount;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//The type index only tracks the first component of a given type, in list order, which
+//matches what the old linear scan of mComponents would have returned.
+void Entity::indexComponentType(Component* comp)
+{
+   StringTableEntry compType = comp->getComponentType();
+
+   if (compType == StringTable->EmptyString())
+      return;
+
+   if (mComponentTypeIndex.find(compType) == mComponentTypeIndex.end())
+      mComponentTypeIndex.insertUnique(compType, comp);
+}
+
+void Entity::unindexComponentType(Component* comp)
+{
+   StringTableEntry compType = comp->getComponentType();
+
+   ComponentTypeIndex::Iterator itr = mComponentTypeIndex.find(compType);
+
+   if (itr == mComponentTypeIndex.end() || itr->value != comp)
+      return;
+
+   mComponentTypeIndex.erase(compType);
+
+   //promote the next component of the same type, if we have one
    for (U32 i = 0; i < mComponents.size(); i++)
    {
-      Component* comp = mComponents[i];
+      if (mComponents[i]->getComponentType() == compType)
+      {
+         mComponentTypeIndex.insertUnique(compType, mComponents[i]);
+         break;
+      }
+   }
+}
+
+void Entity::rebuildComponentTypeIndex()
+{
+   mComponentTypeIndex.clear();
+
+   for (U32 i = 0; i < mComponents.size(); i++)
+      indexComponentType(mComponents[i]);
+}
+
+void Entity::addComponentTypeSlots(Component* comp)
+{
+   const ComponentTypeMask compMask = comp->getComponentTypeMask();
+   const ComponentTypeMask oldMask = mComponentTypeMask;
+   const U32 typeCount = ComponentTypeRegistry::getTypeCount();
 
-      if (comp->getComponentType() == componentType)
-         return comp;
+   if (mComponentTypeSlots.size() < typeCount)
+      mComponentTypeSlots.setSize(typeCount);
+
+   for (U32 i = 0; i < typeCount; i++)
+   {
+      const ComponentTypeMask typeBit = ComponentTypeRegistry::getTypeBit(i);
+
+      if ((compMask & typeBit) && !(mComponentTypeMask & typeBit))
+      {
+         mComponentTypeSlots[i] = comp;
+         mComponentTypeMask |= typeBit;
+      }
    }
 
-   return NULL;
+   EntityQuery::onEntityTypesChanged(this, oldMask, mComponentTypeMask);
+
+   //only newly filled slots can change what a ref points at
+   rebindComponentRefs(mComponentTypeMask & ~oldMask);
+}
+
+void Entity::removeComponentTypeSlots(Component* comp)
+{
+   const ComponentTypeMask oldMask = mComponentTypeMask;
+   const U32 typeCount = mComponentTypeSlots.size();
+   ComponentTypeMask changedTypes = 0;
+
+   for (U32 i = 0; i < typeCount; i++)
+   {
+      const ComponentTypeMask typeBit = ComponentTypeRegistry::getTypeBit(i);
+
+      if (!(mComponentTypeMask & typeBit) || mComponentTypeSlots[i] != comp)
+         continue;
+
+      changedTypes |= typeBit;
+
+      mComponentTypeSlots[i] = NULL;
+      mComponentTypeMask &= ~typeBit;
+
+      //promote the next component that satisfies this type, if we have one
+      for (U32 c = 0; c < mComponents.size(); c++)
+      {
+         if (mComponents[c]->getComponentTypeMask() & typeBit)
+         {
+            mComponentTypeSlots[i] = mComponents[c];
+            mComponentTypeMask |= typeBit;
+            break;
+         }
+      }
+   }
+
+   EntityQuery::onEntityTypesChanged(this, oldMask, mComponentTypeMask);
+
+   rebindComponentRefs(changedTypes);
+}
+
+void Entity::rebindComponentRefs(ComponentTypeMask changedTypes)
+{
+   if (changedTypes == 0)
+      return;
+
+   for (U32 i = 0; i < mComponents.size(); i++)
+      mComponents[i]->rebindComponentRefs(changedTypes);
 }
 
 void Entity::onInspect(GuiInspector* inspector)
@@ -1636,7 +2653,7 @@ void Entity::onCameraScopeQuery(NetConnection* connection, CameraScopeQuery* que
    // Object itself is in scope.
    Parent::onCameraScopeQuery(connection, query);
 
-   CameraComponent* cameraComp = getComponent<CameraComponent>(sCameraComponentType);
+   CameraComponent* cameraComp = getComponent<CameraComponent>();
    if (cameraComp != nullptr)
    {
       cameraComp->onCameraScopeQuery(connection, query);
@@ -1686,17 +2703,130 @@ void Entity::updateContainer()
 }
 //
 
-void Entity::notifyComponents(String signalFunction, String argA, String argB, String argC, String argD, String argE)
+void Entity::notifyComponents(const String& signalFunction, const String& argA, const String& argB, const String& argC, const String& argD, const String& argE)
+{
+   EntityEvent event(EntityEventRegistry::getEventId(signalFunction.c_str()));
+   event.addString(argA.c_str()).addString(argB.c_str()).addString(argC.c_str()).addString(argD.c_str()).addString(argE.c_str());
+
+   fireEvent(event);
+}
+
+Entity::EventListeners* Entity::findEventListeners(EntityEventId eventId, bool create)
+{
+   for (U32 i = 0; i < mEventListeners.size(); i++)
+   {
+      if (mEventListeners[i]->eventId == eventId)
+         return mEventListeners[i];
+   }
+
+   if (!create)
+      return NULL;
+
+   EventListeners* listeners = new EventListeners();
+   listeners->eventId = eventId;
+   listeners->scriptHandlerSequence = 0;
+   listeners->scriptHandlersDirty = true;
+
+   mEventListeners.push_back(listeners);
+
+   return listeners;
+}
+
+void Entity::refreshScriptHandlers(EventListeners* listeners)
 {
+   StringTableEntry methodName = EntityEventRegistry::getEventName(listeners->eventId);
+
+   listeners->scriptHandlers.clear();
+
    for (U32 i = 0; i < mComponents.size(); i++)
    {
-      // We can do this because both are in the string table
-      Component *comp = mComponents[i];
+      if (mComponents[i]->isMethod(methodName))
+         listeners->scriptHandlers.push_back(mComponents[i]);
+   }
+
+   listeners->scriptHandlerSequence = Namespace::mCacheSequence;
+   listeners->scriptHandlersDirty = false;
+}
+
+void Entity::markEventHandlersDirty()
+{
+   for (U32 i = 0; i < mEventListeners.size(); i++)
+      mEventListeners[i]->scriptHandlersDirty = true;
+}
+
+void Entity::clearEventListeners()
+{
+   for (U32 i = 0; i < mEventListeners.size(); i++)
+      delete mEventListeners[i];
+
+   mEventListeners.clear();
+}
+
+Entity::EventSignal& Entity::getEventSignal(EntityEventId eventId)
+{
+   return findEventListeners(eventId, true)->signal;
+}
+
+void Entity::fireEvent(const EntityEvent& event)
+{
+   PROFILE_SCOPE(Entity_FireEvent);
+
+   wakeUp();
+
+   //Any listener may delete us, and our listener table along with us, so we watch for that
+   SimObjectPtr<Entity> self(this);
+
+   EventListeners* listeners = findEventListeners(event.id, true);
+
+   listeners->signal.trigger(this, event);
+
+   if (self.isNull())
+      return;
+
+   if (listeners->scriptHandlersDirty || listeners->scriptHandlerSequence != Namespace::mCacheSequence)
+      refreshScriptHandlers(listeners);
+
+   if (listeners->scriptHandlers.empty())
+      return;
+
+   //Dispatch from a copy, so nothing a handler does to us or our components can pull it out from under us
+   Vector<SimObjectPtr<Component>> handlers;
+   handlers.reserve(listeners->scriptHandlers.size());
+
+   for (U32 i = 0; i < listeners->scriptHandlers.size(); i++)
+      handlers.push_back(listeners->scriptHandlers[i]);
+
+   StringTableEntry methodName = EntityEventRegistry::getEventName(event.id);
+
+   char argBuffers[EntityEvent::MaxArgs][32];
+   const char* argv[EntityEvent::MaxArgs];
 
-      if (comp->isActive())
+   for (U32 i = 0; i < event.argCount; i++)
+      argv[i] = event.formatArg(i, argBuffers[i], sizeof(argBuffers[i]));
+
+   for (U32 i = 0; i < handlers.size(); i++)
+   {
+      //A handler deleted us, so there's nobody left to hear the rest
+      if (self.isNull())
+         return;
+
+      Component* comp = handlers[i];
+
+      //or it removed or deleted this component
+      if (comp == NULL || comp->getOwner() != this)
+         continue;
+
+      if (!comp->isActive())
+         continue;
+
+      switch (event.argCount)
       {
-         if (comp->isMethod(signalFunction))
-            Con::executef(comp, signalFunction, argA, argB, argC, argD, argE);
+         case 0: Con::executef(comp, methodName); break;
+         case 1: Con::executef(comp, methodName, argv[0]); break;
+         case 2: Con::executef(comp, methodName, argv[0], argv[1]); break;
+         case 3: Con::executef(comp, methodName, argv[0], argv[1], argv[2]); break;
+         case 4: Con::executef(comp, methodName, argv[0], argv[1], argv[2], argv[3]); break;
+         default: Con::executef(comp, methodName, argv[0], argv[1], argv[2], argv[3], argv[4]); break;
       }
    }
 }
@@ -1859,6 +2989,32 @@ ConsoleMethod(Entity, addComponents, void, 2, 2, "() - Add all fielded behaviors
    object->addComponents();
 }*/
 
+DefineEngineMethod(Entity, addComponents, S32, (const char* components),,
+   "@brief Add several components to the object at once\n"
+   "@param components Space separated list of the components to add\n"
+   "@return The number of components that were added")
+{
+   Vector<Component*> comps;
+
+   const U32 count = StringUnit::getUnitCount(components, " \t\n");
+   for (U32 i = 0; i < count; i++)
+   {
+      Component* comp;
+      if (Sim::findObject(StringUnit::getUnit(components, i, " \t\n"), comp) && comp->getOwner() != object)
+         comps.push_back(comp);
+   }
+
+   const S32 added = object->addComponents(comps);
+
+   for (U32 i = 0; i < comps.size(); i++)
+   {
+      if (comps[i]->getOwner() == object && comps[i]->isMethod("onBehaviorAdd"))
+         Con::executef(comps[i], "onBehaviorAdd");
+   }
+
+   return added;
+}
+
 DefineEngineMethod(Entity, addComponent, bool, (Component* comp),,
    "@brief Add a behavior to the object\n"
    "@param bi The behavior instance to add"
@@ -1897,6 +3053,20 @@ DefineEngineMethod(Entity, clearComponents, void, (),, "Clear all behavior insta
    object->clearComponents();
 }
 
+DefineEngineMethod(Entity, wakeUp, void, (),,
+   "@brief Wakes a dormant entity so it starts ticking again.\n"
+   "@return No return value")
+{
+   object->wakeUp();
+}
+
+DefineEngineMethod(Entity, isDormant, bool, (),,
+   "@brief Returns whether the entity has gone dormant and stopped ticking.\n"
+   "@return True if the entity is dormant")
+{
+   return object->isDormant();
+}
+
 DefineEngineMethod(Entity, getComponentByIndex, Component*, (S32 index),, 
    "@brief Gets a particular behavior\n"
    "@param index The index of the behavior to get\n"
@@ -1909,7 +3079,7 @@ DefineEngineMethod(Entity, getComponent, Component*, (String componentName), (""
    "Get the number of static fields on the object.\n"
    "@return The number of static fields defined on the object.")
 {
-   return object->getComponent(componentName);
+   return object->getComponent(StringTable->insert(componentName));
 }
 
 /*ConsoleMethod(Entity, getBehaviorByType, S32, 3, 3, "(string BehaviorTemplateName) - gets a behavior\n"
@@ -2028,41 +3198,116 @@ DefineEngineMethod(Entity, notify, void, (String signalFunction, String argA, St
    object->notifyComponents(signalFunction, argA, argB, argC, argD, argE);
 }
 
+//////////////////////////////////////////////////////////////////////////
+void Entity::setTags(const char* tags)
+{
+   unindexTags();
+
+   mTags = tags ? tags : "";
+   mTagBits.clear();
+
+   const char* delims = " \t\n,";
+   const U32 tagCount = StringUnit::getUnitCount(mTags, delims);
+   for (U32 i = 0; i < tagCount; i++)
+   {
+      const char* tagName = StringUnit::getUnit(mTags, i, delims);
+      if (tagName[0] == '\0')
+         continue;
+
+      const U32 tagId = EntityTagIndex::getTagId(tagName);
+      const U32 word = tagId >> 5;
+
+      while (mTagBits.size() <= word)
+         mTagBits.push_back(0);
+
+      mTagBits[word] |= BIT(tagId & 31);
+   }
+
+   if (isProperlyAdded() && isServerObject())
+      indexTags();
+}
+
+bool Entity::hasTag(const char* tagName) const
+{
+   U32 tagId = EntityTagIndex::findTagId(tagName);
+   return tagId != EntityTagIndex::InvalidTagId && hasTag(tagId);
+}
+
+void Entity::indexTags()
+{
+   AssertFatal(mTagSlots.empty(), "Entity::indexTags() - Tags are already indexed.");
+
+   for (U32 word = 0; word < mTagBits.size(); word++)
+   {
+      for (U32 bit = 0; bit < 32; bit++)
+      {
+         if (mTagBits[word] & BIT(bit))
+            EntityTagIndex::addEntity(this, (word << 5) + bit);
+      }
+   }
+}
+
+void Entity::unindexTags()
+{
+   while (!mTagSlots.empty())
+      EntityTagIndex::removeEntity(this, mTagSlots.last().tagId);
+}
+
+DefineEngineMethod(Entity, hasTag, bool, (const char* tag), (""),
+   "Checks if this entity carries a tag.\n"
+   "@param tag The tag to check for.\n"
+   "@return True if the entity has the tag.")
+{
+   return object->hasTag(tag);
+}
+
 DefineEngineFunction(findEntitiesByTag, const char*, (SimGroup* searchingGroup, String tags), (nullAsType<SimGroup*>(), ""),
 "Finds all entities that have the provided tags.\n"
-"@param searchingGroup The SimGroup to search inside. If null, we'll search the entire dictionary(this can be slow!).\n"
+"@param searchingGroup Only return entities inside this SimGroup. If null, every tagged entity is considered.\n"
 "@param tags Word delimited list of tags to search for. If multiple tags are included, the list is eclusively parsed, requiring all tags provided to be found on an entity for a match.\n"
 "@return A word list of IDs of entities that match the tag search terms.")
 {
-   //if (tags.isEmpty())
+   if (tags.isEmpty())
       return "";
 
-   /*if (searchingGroup == nullptr)
-   {
-      searchingGroup = Sim::getRootGroup();
-   }
+   const char* delims = " \t\n,";
+   const U32 tagCount = StringUnit::getUnitCount(tags, delims);
 
-   StringTableEntry entityStr = StringTable->insert("Entity");
+   Vector<U32> tagIds;
+   tagIds.reserve(tagCount);
 
-   std::thread threadBob;
+   for (U32 i = 0; i < tagCount; i++)
+   {
+      const char* tagName = StringUnit::getUnit(tags, i, delims);
+      if (tagName[0] == '\0')
+         continue;
 
-   std::thread::id a = threadBob.get_id();
-   std::thread::id b = std::this_thread::get_id().;
+      //a tag nobody has ever used can't match anything
+      U32 tagId = EntityTagIndex::findTagId(tagName);
+      if (tagId == EntityTagIndex::InvalidTagId)
+         return "";
 
-   if (a == b)
-   {
-      //do
+      tagIds.push_back(tagId);
    }
 
-   for (SimGroup::iterator itr = searchingGroup->begin(); itr != searchingGroup->end(); itr++)
+   Vector<Entity*> entities;
+   EntityTagIndex::findEntities(tagIds.address(), tagIds.size(), entities);
+
+   if (entities.empty())
+      return "";
+
+   const U32 bufSize = entities.size() * 12;
+   char* returnBuffer = Con::getReturnBuffer(bufSize);
+   returnBuffer[0] = '\0';
+
+   U32 len = 0;
+   for (U32 i = 0; i < entities.size(); i++)
    {
-      Entity* ent = dynamic_cast<Entity*>((*itr));
+      if (searchingGroup != nullptr && !entities[i]->isChildOfGroup(searchingGroup))
+         continue;
 
-      if (ent != nullptr)
-      {
-         ent->mTags.
-      }
+      len += dSprintf(returnBuffer + len, bufSize - len, len == 0 ? "%d" : " %d", entities[i]->getId());
    }
 
-   object->notifyComponents(signalFunction, argA, argB, argC, argD, argE);*/
+   return returnBuffer;
 }
@@ -29,6 +29,9 @@
 #ifndef _MOVEMANAGER_H_
 #include "T3D/gameBase/moveManager.h"
 #endif
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#include "components/componentTypeRegistry.h"
+#endif
 #ifndef COMPONENT_H
 #include "components/component.h"
 #endif
@@ -41,6 +44,21 @@
 #ifndef GAME_OBJECT_ASSET_H
 #include "T3D/assets/GameObjectAsset.h"
 #endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+#ifndef ENTITY_TIMER_WHEEL_H
+#include "entityTimerWheel.h"
+#endif
+#ifndef ENTITY_EVENT_H
+#include "entityEvent.h"
+#endif
+#ifndef ENTITY_OBJECT_POOL_H
+#include "entityObjectPool.h"
+#endif
+#ifndef ENTITY_TAG_INDEX_H
+#include "entityTagIndex.h"
+#endif
 
 class Component;
 
@@ -51,32 +69,114 @@ class Entity : public GameBase
 {
    typedef GameBase Parent;
    friend class Component;
+   friend class EntityTimerWheel;
+   friend class EntityTagIndex;
+   friend class EntityQuery;
+   friend class EntityInterpolationBatch;
 
 private:
    Point3F             mPos;
    RotationF           mRot;
 
+   //mRot as a quaternion, kept in step with it, so interpolation and change tests don't have to convert
+   QuatF               mRotQuat;
+
+   void assignRotation(const RotationF& rotation)
+   {
+      mRot = rotation;
+      mRotQuat = rotation.asQuatF();
+   }
+
+   //Common tail of the unmounted setTransforms, once the caller has worked out every form of the new transform
+   void applyTransform(const Point3F& position, const RotationF& rotation, const QuatF& rotQuat, const MatrixF& mat);
+
+   //Render transform handed back from the client's EntityInterpolationBatch
+   void applyInterpolatedTransform(const Point3F& position, const QuatF& rotQuat, F32 dt);
+
    Vector<Component*>         mComponents;
 
-   //Bit of helper data to let us track and manage the adding, removal and updating of networked components
+   //Components that implement processTick, for ticking client ghosts. Server components go through the tick scheduler
+   Vector<Component*>         mTickComponents;
+
+   //Components that asked to hear about our transform changing, per Component::TransformChannels
+   Vector<Component*>         mTransformListeners;
+   Vector<Component*>         mRenderTransformListeners;
+
+   void addTransformListener(Component* comp);
+
+   //Lookup of interned component type -> first component of that type in mComponents.
+   //Keys are StringTableEntries, so we hash and compare the pointer rather than the string.
+   typedef HashTable<const void*, Component*> ComponentTypeIndex;
+   ComponentTypeIndex         mComponentTypeIndex;
+
+   //Native class lookup. mComponentTypeMask has a bit set for every component type id we
+   //have a component for, and mComponentTypeSlots holds the first such component per type id.
+   ComponentTypeMask          mComponentTypeMask;
+   Vector<Component*>         mComponentTypeSlots;
+
+   //Our slot in the EntityQuery tracking list, -1 if we're not tracked
+   S32                        mQueryIndex;
+
+   //Our slot in the client EntityInterpolationBatch, -1 if we're not in it
+   S32                        mInterpolationIndex;
+
+   //World transform while we're mounted. Rebuilding it walks the mount chain, so it's cached and
+   //flagged dirty whenever we, our mount offset, or anything above us in the mount tree moves
+   MatrixF                    mMountedTransform;
+   bool                       mMountedTransformDirty;
+
+   const MatrixF& getMountedTransform();
+   void markMountedTransformDirty();
+
+   //Bit of helper data to let us track and manage the adding, removal and updating of networked components.
+   //Indexed by net slot, the stable id the server and its clients both know each networked component by
    struct NetworkedComponent
    {
-      U32 componentIndex;
+      Component* component;         ///< NULL for a free slot
+      U8 generation;                ///< Bumped every time the slot is handed out, so a client can tell a reused slot from the one it has
+   };
+
+   Vector<NetworkedComponent> mNetworkedComponents;
+
+   //Server side
+   Vector<U32>                mFreeNetSlots;
+
+   //Server side. What each connection ghosting us still has to be sent of our networked components. Connections
+   //pack on their own schedules and budgets, so component mask bits are tracked per ghost.
+   //
+   //Adds and removals aren't tracked per ghost at all. We can't tell when a packet has been delivered, only that
+   //a dropped one puts its mask bits back, so whenever they're pending we send the whole slot map and let the
+   //client reconcile against it. Sending the map also queues every component's full state, in case the ghost
+   //ends up creating it from this map rather than an earlier one.
+   struct GhostComponentState
+   {
+      SimObjectPtr<NetConnection> connection;
 
-      enum UpdateState
-      {
-         None,
-         Adding,
-         Removing,
-         Updating
-      };
+      Vector<U32> slotMasks;        ///< Component mask bits this ghost has yet to be sent
 
-      UpdateState updateState;
+      //One bit per net slot with mask bits pending, so packing only ever touches the slots that changed
+      Vector<U32> dirtySlots;
+      U32 dirtyCount;
 
-      U32 updateMaskBits;
+      GhostComponentState(NetConnection* con);
+
+      void addSlotMask(U32 netSlot, U32 mask);
+      void setSlotMask(U32 netSlot, U32 mask);
+      void resize(U32 count);
+      void getDirtySlots(Vector<U32>& outSlots) const;
    };
 
-   Vector<NetworkedComponent> mNetworkedComponents;
+   Vector<GhostComponentState*> mGhostComponentStates;
+
+   void addNetworkedComponent(Component* comp);
+   void removeNetworkedComponent(Component* comp);
+   void resizeNetSlots(U32 count);
+   void clearNetSlots();
+
+   GhostComponentState* getGhostComponentState(NetConnection* con);
+
+   /// Client side. Swaps whatever's in netSlot for a new component of the given class, or just clears it
+   void setGhostNetSlot(U32 netSlot, U8 generation, Component* comp);
 
    U32                        mComponentNetMask;
 
@@ -91,10 +191,75 @@ private:
 
    String mTags;
 
+   //Interned tag ids as a bitset, and where we sit in each tag's entity list in the EntityTagIndex
+   Vector<U32>                mTagBits;
+
+   struct TagSlot
+   {
+      U32 tagId;
+      U32 index;
+   };
+   Vector<TagSlot>            mTagSlots;
+
+   void indexTags();
+   void unindexTags();
+
    Signal< void(Component*) > onComponentAdded;
    Signal< void(Component*) > onComponentRemoved;
 
    S32                       mLifetimeMS;
+   EntityTimerWheel::Timer*  mLifetimeTimer;
+
+   EntityTimerWheel* getTimerWheel();
+   void scheduleLifetime();
+   void cancelLifetime();
+
+   //Dormancy. Idle server entities drop out of the process list until something wakes them
+   bool                      mDormant;
+   U32                       mIdleTicks;
+
+   void updateDormancy();
+
+   //Which of the well-known script callbacks our namespace has, refreshed when the namespace or
+   //the console's namespace cache sequence changes
+   U32                       mScriptCallbackMask;
+   Namespace*                mScriptCallbackNamespace;
+   U32                       mScriptCallbackSequence;
+
+   void refreshScriptCallbacks();
+
+public:
+   typedef Signal< void(Entity*, const EntityEvent&) > EventSignal;
+
+private:
+   //Subscribers for one event id. Native listeners hook the signal; the script side is the
+   //list of components implementing the event's method, rebuilt when our components or the
+   //console's namespace cache change. Held by pointer since signals can't be relocated.
+   struct EventListeners
+   {
+      EntityEventId        eventId;
+      EventSignal          signal;
+      Vector<Component*>   scriptHandlers;
+      U32                  scriptHandlerSequence;
+      bool                 scriptHandlersDirty;
+   };
+
+   Vector<EventListeners*>   mEventListeners;
+
+   EventListeners* findEventListeners(EntityEventId eventId, bool create);
+   void refreshScriptHandlers(EventListeners* listeners);
+   void markEventHandlersDirty();
+   void clearEventListeners();
+
+   //Points our components' ComponentRefs back at the right siblings after the slots for changedTypes moved
+   void rebindComponentRefs(ComponentTypeMask changedTypes);
+
+   void indexComponentType(Component* comp);
+   void unindexComponentType(Component* comp);
+   void rebuildComponentTypeIndex();
+
+   void addComponentTypeSlots(Component* comp);
+   void removeComponentTypeSlots(Component* comp);
 
 protected:
    //Marked if this entity is a GameObject and deliniates from the parent GO asset
@@ -125,6 +290,18 @@ public:
       QuatF warpRot[2];
    };
 
+   /// Script callbacks the entity looks for every tick, cached so a miss is one bit test
+   enum ScriptCallbacks
+   {
+      MoveVectorCallback = BIT(0),
+      MoveYawCallback = BIT(1),
+      MovePitchCallback = BIT(2),
+      MoveRollCallback = BIT(3),
+      MoveTriggerCallback = BIT(4),
+      ProcessTickCallback = BIT(5),
+      CollisionEventCallback = BIT(6)
+   };
+
    enum MaskBits
    {
       TransformMask = Parent::NextFreeMask << 0,
@@ -134,21 +311,53 @@ public:
       RemoveComponentsMask = Parent::NextFreeMask << 4,
       NoWarpMask = Parent::NextFreeMask << 5,
       NamespaceMask = Parent::NextFreeMask << 6,
-      NextFreeMask = Parent::NextFreeMask << 7
+      MoveMask = Parent::NextFreeMask << 7,
+      TransformKeyframeMask = Parent::NextFreeMask << 8,
+      NextFreeMask = Parent::NextFreeMask << 9
    };
 
    StateDelta mDelta;
    S32 mPredictionCount;            ///< Number of ticks to predict
 
+   Point3F  mNetPos;                ///< Position as of the last transform update we packed
+   QuatF    mNetRotQuat;            ///< Rotation as of the last transform update we packed
+
+   Point3F  mKeyframePos;           ///< Position transform updates are sent relative to
+   S32      mKeyframeSeq;           ///< Which keyframe mKeyframePos is. -1 on a client that hasn't had one yet
+
+   /// Starts a new position keyframe once we've wandered too far from the current one
+   void updateTransformKeyframe();
+
    Move lastMove;
 
-   S32      mStartTimeMS;
+   U32      mStartTick;              ///< Timer wheel tick our lifetime counts from
 
    //
    Entity();
    ~Entity();
 
    static void    initPersistFields();
+   static void    consoleInit();
+
+   /// Number of consecutive idle ticks before a server entity goes dormant. 0 disables dormancy.
+   static S32     smDormantTickThreshold;
+
+   /// Bits of component updates packed per entity update. 0 is unlimited.
+   static S32     smComponentUpdateBudget;
+
+   /// How much our component updates matter to con, from whether it controls us and how far its camera is
+   F32 getComponentUpdatePriority(NetConnection* con);
+
+   /// Returns true if our script namespace implements the given ScriptCallbacks bit
+   bool hasScriptCallback(U32 callback);
+
+   /// Fired on the server for every move we process, with the new move and the previous one,
+   /// so native components can react to input without going through script
+   Signal< void(const Move&, const Move&) > onMoveEvent;
+
+   /// Puts a dormant entity back in the process list. Safe to call on entities that are awake.
+   void wakeUp();
+   bool isDormant() const { return mDormant; }
    virtual void onPostAdd();
 
    virtual void setTransform(const MatrixF &mat);
@@ -162,12 +371,14 @@ public:
    virtual Point3F getPosition() const { return mPos; }
 
    void setRotation(const RotationF& rotation) {
-      mRot = rotation;
+      assignRotation(rotation);
       setMaskBits(TransformMask);
+      wakeUp();
    };
    RotationF getRotation() { return mRot; }
 
    static bool _setGameObject(void *object, const char *index, const char *data);
+   static bool _setTags(void *object, const char *index, const char *data);
 
    void setMountOffset(const Point3F& posOffset);
    void setMountRotation(const EulerF& rotOffset);
@@ -179,6 +390,18 @@ public:
    static bool _setRotation(void *object, const char *index, const char *data);
    static const char * _getRotation(void* obj, const char* data);
 
+   //Tags
+   void setTags(const char* tags);
+   const String& getTags() const { return mTags; }
+
+   bool hasTag(U32 tagId) const
+   {
+      const U32 word = tagId >> 5;
+      return word < mTagBits.size() && (mTagBits[word] & BIT(tagId & 31)) != 0;
+   }
+
+   bool hasTag(const char* tagName) const;
+
    virtual void getMountTransform(S32 index, const MatrixF &xfm, MatrixF *outMat);
    virtual void getRenderMountTransform(F32 delta, S32 index, const MatrixF &xfm, MatrixF *outMat);
 
@@ -206,13 +429,40 @@ public:
    //Components
    virtual bool deferAddingComponents() const { return true; }
 
-   void notifyComponents(String signalFunction, String argA, String argB="", String argC = "", String argD = "", String argE = "");
+   /// Fires an event at our native subscribers, then at any active components with a script
+   /// method named after the event
+   void fireEvent(const EntityEvent& event);
+
+   /// Subscribe here to receive an event natively, eg. getEventSignal(id).notify(this, &MyComponent::onEvent)
+   EventSignal& getEventSignal(EntityEventId eventId);
+
+   /// String wrapper around fireEvent, kept for script and older callers
+   void notifyComponents(const String& signalFunction, const String& argA, const String& argB = String::EmptyString, 
+      const String& argC = String::EmptyString, const String& argD = String::EmptyString, const String& argE = String::EmptyString);
 
    Component* getComponent(StringTableEntry componentType);
 
    template <class T>
    T* getComponent(StringTableEntry componentType);
 
+   /// Finds the first component that is, or derives from, the native class T.
+   template <class T>
+   T* getComponent();
+
+   bool hasComponentTypes(ComponentTypeMask typeMask) const
+   {
+      return (mComponentTypeMask & typeMask) == typeMask;
+   }
+
+   ComponentTypeMask getComponentTypeMask() const { return mComponentTypeMask; }
+
+   /// Fetches several component types in one go.
+   /// @param componentTypes  Interned component type names to look up
+   /// @param typeCount       Number of entries in componentTypes
+   /// @param outComponents   Receives a component (or NULL) for each requested type, in the same order
+   /// @return The number of requested types that were found
+   U32 getComponents(const StringTableEntry* componentTypes, U32 typeCount, Component** outComponents);
+
    U32 getComponentCount() const
    { 
       return mComponents.size(); 
@@ -252,6 +502,11 @@ public:
 
    //component stuff
    bool addComponent(Component *comp);
+
+   /// Adds a set of components in one go. They're all inserted before any of them initialize, so each
+   /// resolves its dependencies once in onComponentAdd, and only components we already had hear about
+   /// the new ones. Returns the number of components added.
+   U32 addComponents(const Vector<Component*>& components);
    bool removeComponent(Component *comp, bool deleteComponent);
    void clearComponents(bool deleteComponents = true);
    Component* getComponent(const U32 index) const;
@@ -286,21 +541,27 @@ public:
    StateDelta getNetworkDelta() { return mDelta; }
 
    DECLARE_CONOBJECT(Entity);
+
+   DECLARE_ENTITY_POOL_ALLOCATOR();
 };
 
 template <class T>
 T* Entity::getComponent(StringTableEntry componentType)
 {
-   U32 componentCount = getComponentCount();
-   for (U32 i = 0; i < componentCount; i++)
-   {
-      if (mComponents[i]->getComponentType() == componentType)
-      {
-         T* t = static_cast<T*>(mComponents[i]);
-         return t;
-      }
-   }
-   return NULL;
+   //the type string is script-settable, so make sure it really is what the caller thinks it is
+   return dynamic_cast<T*>(getComponent(componentType));
+}
+
+template <class T>
+T* Entity::getComponent()
+{
+   const U32 typeId = T::getStaticComponentTypeId();
+
+   if (!(mComponentTypeMask & ComponentTypeRegistry::getTypeBit(typeId)))
+      return NULL;
+
+   //slots only ever hold components whose type mask includes T, so this is safe
+   return static_cast<T*>(mComponentTypeSlots[typeId]);
 }
 
 #endif //ENTITY_H
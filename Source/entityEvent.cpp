@@ -0,0 +1,191 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityEvent.h"
+#include "console/console.h"
+#include "console/simBase.h"
+#include "core/util/tVector.h"
+#include "core/util/tDictionary.h"
+
+namespace
+{
+   Vector<StringTableEntry>& getEventNames()
+   {
+      static Vector<StringTableEntry> sEventNames;
+      return sEventNames;
+   }
+
+   HashTable<const void*, EntityEventId>& getEventIds()
+   {
+      static HashTable<const void*, EntityEventId> sEventIds;
+      return sEventIds;
+   }
+}
+
+EntityEventId EntityEventRegistry::getEventId(const char* eventName)
+{
+   StringTableEntry name = StringTable->insert(eventName);
+
+   HashTable<const void*, EntityEventId>& eventIds = getEventIds();
+   HashTable<const void*, EntityEventId>::Iterator itr = eventIds.find(name);
+
+   if (itr != eventIds.end())
+      return itr->value;
+
+   EntityEventId newId = getEventNames().size();
+   getEventNames().push_back(name);
+   eventIds.insertUnique(name, newId);
+
+   return newId;
+}
+
+StringTableEntry EntityEventRegistry::getEventName(EntityEventId eventId)
+{
+   if (eventId >= getEventNames().size())
+      return StringTable->EmptyString();
+
+   return getEventNames()[eventId];
+}
+
+//////////////////////////////////////////////////////////////////////////
+EntityEvent& EntityEvent::addInt(S32 value)
+{
+   //extra arguments are dropped rather than written past the end, as the event is still worth firing
+   if (argCount >= MaxArgs)
+   {
+      Con::errorf("EntityEvent::addInt() - Too many event arguments, the limit is %i.", (S32)MaxArgs);
+      return *this;
+   }
+
+   args[argCount].type = Arg::Int;
+   args[argCount++].intValue = value;
+   return *this;
+}
+
+EntityEvent& EntityEvent::addFloat(F32 value)
+{
+   if (argCount >= MaxArgs)
+   {
+      Con::errorf("EntityEvent::addFloat() - Too many event arguments, the limit is %i.", (S32)MaxArgs);
+      return *this;
+   }
+
+   args[argCount].type = Arg::Float;
+   args[argCount++].floatValue = value;
+   return *this;
+}
+
+EntityEvent& EntityEvent::addObject(SimObject* obj)
+{
+   if (argCount >= MaxArgs)
+   {
+      Con::errorf("EntityEvent::addObject() - Too many event arguments, the limit is %i.", (S32)MaxArgs);
+      return *this;
+   }
+
+   args[argCount].type = Arg::Object;
+   args[argCount++].objectId = obj ? obj->getId() : 0;
+   return *this;
+}
+
+EntityEvent& EntityEvent::addString(const char* value)
+{
+   if (argCount >= MaxArgs)
+   {
+      Con::errorf("EntityEvent::addString() - Too many event arguments, the limit is %i.", (S32)MaxArgs);
+      return *this;
+   }
+
+   args[argCount].type = Arg::String;
+   args[argCount++].stringValue = value ? value : "";
+   return *this;
+}
+
+S32 EntityEvent::getInt(U32 idx) const
+{
+   if (idx >= argCount)
+      return 0;
+
+   switch (args[idx].type)
+   {
+      case Arg::Int:    return args[idx].intValue;
+      case Arg::Float:  return (S32)args[idx].floatValue;
+      case Arg::Object: return args[idx].objectId;
+      default:          return dAtoi(args[idx].stringValue);
+   }
+}
+
+F32 EntityEvent::getFloat(U32 idx) const
+{
+   if (idx >= argCount)
+      return 0.0f;
+
+   switch (args[idx].type)
+   {
+      case Arg::Int:    return (F32)args[idx].intValue;
+      case Arg::Float:  return args[idx].floatValue;
+      case Arg::Object: return (F32)args[idx].objectId;
+      default:          return dAtof(args[idx].stringValue);
+   }
+}
+
+SimObject* EntityEvent::getObject(U32 idx) const
+{
+   if (idx >= argCount)
+      return NULL;
+
+   if (args[idx].type == Arg::String)
+      return Sim::findObject(args[idx].stringValue);
+
+   return Sim::findObject((SimObjectId)getInt(idx));
+}
+
+const char* EntityEvent::getString(U32 idx) const
+{
+   if (idx >= argCount || args[idx].type != Arg::String)
+      return "";
+
+   return args[idx].stringValue;
+}
+
+const char* EntityEvent::formatArg(U32 idx, char* buffer, U32 bufferSize) const
+{
+   if (idx >= argCount)
+      return "";
+
+   switch (args[idx].type)
+   {
+      case Arg::Int:
+         dSprintf(buffer, bufferSize, "%d", args[idx].intValue);
+         return buffer;
+      case Arg::Float:
+         dSprintf(buffer, bufferSize, "%g", args[idx].floatValue);
+         return buffer;
+      case Arg::Object:
+         dSprintf(buffer, bufferSize, "%u", args[idx].objectId);
+         return buffer;
+      default:
+         return args[idx].stringValue;
+   }
+}
@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_EVENT_H
+#define ENTITY_EVENT_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _STRINGTABLE_H_
+#include "core/stringTable.h"
+#endif
+
+class SimObject;
+
+typedef U32 EntityEventId;
+
+//////////////////////////////////////////////////////////////////////////
+/// Maps event names to dense ids. Look an id up once and keep it, rather than
+/// passing the event name around every time the event fires.
+//////////////////////////////////////////////////////////////////////////
+class EntityEventRegistry
+{
+public:
+   /// Returns the id for the named event, registering it if this is the first we've heard of it
+   static EntityEventId getEventId(const char* eventName);
+
+   /// The event name, which is also the script method a component implements to handle it
+   static StringTableEntry getEventName(EntityEventId eventId);
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// An event fired through Entity::fireEvent. It's plain data and lives on the
+/// stack, so firing one doesn't allocate anything.
+///
+/// String arguments aren't copied, so they only need to stay valid for the
+/// duration of the fireEvent call.
+//////////////////////////////////////////////////////////////////////////
+struct EntityEvent
+{
+   enum
+   {
+      MaxArgs = 5
+   };
+
+   struct Arg
+   {
+      enum Type
+      {
+         Int,
+         Float,
+         Object,
+         String
+      };
+
+      Type type;
+
+      union
+      {
+         S32 intValue;
+         F32 floatValue;
+         U32 objectId;
+         const char* stringValue;
+      };
+   };
+
+   EntityEventId id;
+   U32 argCount;
+   Arg args[MaxArgs];
+
+   EntityEvent(EntityEventId eventId) : id(eventId), argCount(0) {}
+
+   EntityEvent& addInt(S32 value);
+   EntityEvent& addFloat(F32 value);
+   EntityEvent& addObject(SimObject* obj);
+   EntityEvent& addString(const char* value);
+
+   S32 getInt(U32 idx) const;
+   F32 getFloat(U32 idx) const;
+   SimObject* getObject(U32 idx) const;
+   const char* getString(U32 idx) const;
+
+   /// Formats an argument for passing to script. Non-string arguments are written
+   /// into buffer, which should be at least 32 characters.
+   const char* formatArg(U32 idx, char* buffer, U32 bufferSize) const;
+};
+
+#endif // ENTITY_EVENT_H
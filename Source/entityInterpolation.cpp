@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityInterpolation.h"
+#include "entity.h"
+#include "T3D/gameBase/gameProcess.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#define ENTITY_INTERPOLATION_SSE
+#include <xmmintrin.h>
+#endif
+
+EntityInterpolationBatch::EntityInterpolationBatch()
+{
+   mLastSimTime = 0;
+   mLastTickCount = 0;
+   mLastDt = -1.0f;
+   mStateChanged = true;
+}
+
+EntityInterpolationBatch* EntityInterpolationBatch::getClient()
+{
+   static EntityInterpolationBatch sClientBatch;
+   return &sClientBatch;
+}
+
+void EntityInterpolationBatch::resize(U32 count)
+{
+   mPosX.setSize(count); mPosY.setSize(count); mPosZ.setSize(count);
+   mVecX.setSize(count); mVecY.setSize(count); mVecZ.setSize(count);
+   mFromX.setSize(count); mFromY.setSize(count); mFromZ.setSize(count); mFromW.setSize(count);
+   mToX.setSize(count); mToY.setSize(count); mToZ.setSize(count); mToW.setSize(count);
+
+   mOutPosX.setSize(count); mOutPosY.setSize(count); mOutPosZ.setSize(count);
+   mOutRotX.setSize(count); mOutRotY.setSize(count); mOutRotZ.setSize(count); mOutRotW.setSize(count);
+}
+
+void EntityInterpolationBatch::addEntity(Entity* entity)
+{
+   if (entity->mInterpolationIndex != -1)
+      return;
+
+   entity->mInterpolationIndex = mEntities.size();
+   mEntities.push_back(entity);
+
+   resize(mEntities.size());
+   updateEntity(entity);
+}
+
+void EntityInterpolationBatch::removeEntity(Entity* entity)
+{
+   const S32 index = entity->mInterpolationIndex;
+   if (index == -1)
+      return;
+
+   //Swap the last entity into the hole, state and all
+   const U32 last = mEntities.size() - 1;
+   Entity* moved = mEntities[last];
+
+   mEntities[index] = moved;
+   moved->mInterpolationIndex = index;
+   entity->mInterpolationIndex = -1;
+
+   mPosX[index] = mPosX[last]; mPosY[index] = mPosY[last]; mPosZ[index] = mPosZ[last];
+   mVecX[index] = mVecX[last]; mVecY[index] = mVecY[last]; mVecZ[index] = mVecZ[last];
+   mFromX[index] = mFromX[last]; mFromY[index] = mFromY[last]; mFromZ[index] = mFromZ[last]; mFromW[index] = mFromW[last];
+   mToX[index] = mToX[last]; mToY[index] = mToY[last]; mToZ[index] = mToZ[last]; mToW[index] = mToW[last];
+
+   mEntities.pop_back();
+   resize(mEntities.size());
+}
+
+void EntityInterpolationBatch::updateEntity(Entity* entity)
+{
+   const S32 index = entity->mInterpolationIndex;
+   if (index == -1)
+      return;
+
+   const Entity::StateDelta& delta = entity->mDelta;
+
+   mPosX[index] = delta.pos.x; mPosY[index] = delta.pos.y; mPosZ[index] = delta.pos.z;
+   mVecX[index] = delta.posVec.x; mVecY[index] = delta.posVec.y; mVecZ[index] = delta.posVec.z;
+
+   mFromX[index] = delta.rot[1].x; mFromY[index] = delta.rot[1].y; mFromZ[index] = delta.rot[1].z; mFromW[index] = delta.rot[1].w;
+   mToX[index] = delta.rot[0].x; mToY[index] = delta.rot[0].y; mToZ[index] = delta.rot[0].z; mToW[index] = delta.rot[0].w;
+
+   mStateChanged = true;
+}
+
+void EntityInterpolationBatch::computeScalar(U32 start, U32 end, F32 dt)
+{
+   for (U32 i = start; i < end; i++)
+   {
+      mOutPosX[i] = mPosX[i] + mVecX[i] * dt;
+      mOutPosY[i] = mPosY[i] + mVecY[i] * dt;
+      mOutPosZ[i] = mPosZ[i] + mVecZ[i] * dt;
+
+      //Take the short way round
+      F32 cosom = mFromX[i] * mToX[i] + mFromY[i] * mToY[i] + mFromZ[i] * mToZ[i] + mFromW[i] * mToW[i];
+      F32 sign = cosom < 0.0f ? -1.0f : 1.0f;
+
+      F32 x = mFromX[i] + (mToX[i] * sign - mFromX[i]) * dt;
+      F32 y = mFromY[i] + (mToY[i] * sign - mFromY[i]) * dt;
+      F32 z = mFromZ[i] + (mToZ[i] * sign - mFromZ[i]) * dt;
+      F32 w = mFromW[i] + (mToW[i] * sign - mFromW[i]) * dt;
+
+      F32 lenSq = x * x + y * y + z * z + w * w;
+      F32 invLen = lenSq > 0.0f ? 1.0f / mSqrt(lenSq) : 0.0f;
+
+      mOutRotX[i] = x * invLen;
+      mOutRotY[i] = y * invLen;
+      mOutRotZ[i] = z * invLen;
+      mOutRotW[i] = lenSq > 0.0f ? w * invLen : 1.0f;
+   }
+}
+
+void EntityInterpolationBatch::computeSSE(U32 end, F32 dt)
+{
+#ifdef ENTITY_INTERPOLATION_SSE
+   const __m128 vdt = _mm_set1_ps(dt);
+   const __m128 zero = _mm_setzero_ps();
+   const __m128 signBit = _mm_set1_ps(-0.0f);
+   const __m128 one = _mm_set1_ps(1.0f);
+
+   for (U32 i = 0; i < end; i += 4)
+   {
+      //positions
+      _mm_storeu_ps(&mOutPosX[i], _mm_add_ps(_mm_loadu_ps(&mPosX[i]), _mm_mul_ps(_mm_loadu_ps(&mVecX[i]), vdt)));
+      _mm_storeu_ps(&mOutPosY[i], _mm_add_ps(_mm_loadu_ps(&mPosY[i]), _mm_mul_ps(_mm_loadu_ps(&mVecY[i]), vdt)));
+      _mm_storeu_ps(&mOutPosZ[i], _mm_add_ps(_mm_loadu_ps(&mPosZ[i]), _mm_mul_ps(_mm_loadu_ps(&mVecZ[i]), vdt)));
+
+      //rotations
+      __m128 fx = _mm_loadu_ps(&mFromX[i]), fy = _mm_loadu_ps(&mFromY[i]), fz = _mm_loadu_ps(&mFromZ[i]), fw = _mm_loadu_ps(&mFromW[i]);
+      __m128 tx = _mm_loadu_ps(&mToX[i]), ty = _mm_loadu_ps(&mToY[i]), tz = _mm_loadu_ps(&mToZ[i]), tw = _mm_loadu_ps(&mToW[i]);
+
+      //flip the target wherever the dot product is negative, to take the short way round
+      __m128 cosom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(fx, tx), _mm_mul_ps(fy, ty)), _mm_add_ps(_mm_mul_ps(fz, tz), _mm_mul_ps(fw, tw)));
+      __m128 flip = _mm_and_ps(cosom, signBit);
+      tx = _mm_xor_ps(tx, flip); ty = _mm_xor_ps(ty, flip); tz = _mm_xor_ps(tz, flip); tw = _mm_xor_ps(tw, flip);
+
+      __m128 x = _mm_add_ps(fx, _mm_mul_ps(_mm_sub_ps(tx, fx), vdt));
+      __m128 y = _mm_add_ps(fy, _mm_mul_ps(_mm_sub_ps(ty, fy), vdt));
+      __m128 z = _mm_add_ps(fz, _mm_mul_ps(_mm_sub_ps(tz, fz), vdt));
+      __m128 w = _mm_add_ps(fw, _mm_mul_ps(_mm_sub_ps(tw, fw), vdt));
+
+      //Full precision divide rather than rsqrt, so we match the scalar path
+      __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+      __m128 valid = _mm_cmpgt_ps(lenSq, zero);
+      __m128 invLen = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(lenSq)), valid);
+
+      _mm_storeu_ps(&mOutRotX[i], _mm_mul_ps(x, invLen));
+      _mm_storeu_ps(&mOutRotY[i], _mm_mul_ps(y, invLen));
+      _mm_storeu_ps(&mOutRotZ[i], _mm_mul_ps(z, invLen));
+      //degenerate quats come out as identity
+      _mm_storeu_ps(&mOutRotW[i], _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(w, invLen)), _mm_andnot_ps(valid, one)));
+   }
+#endif
+}
+
+void EntityInterpolationBatch::interpolate(F32 dt)
+{
+   //Everything in the process list gets interpolated with the same dt in the same frame, so the first
+   //entity through here does the work for all of them
+   const U32 simTime = Sim::getCurrentTime();
+   const U32 tickCount = ClientProcessList::get()->getTotalTicks();
+
+   if (!mStateChanged && simTime == mLastSimTime && tickCount == mLastTickCount && dt == mLastDt)
+      return;
+
+   mLastSimTime = simTime;
+   mLastTickCount = tickCount;
+   mLastDt = dt;
+   mStateChanged = false;
+
+   PROFILE_SCOPE(EntityInterpolationBatch_interpolate);
+
+   const U32 count = mEntities.size();
+
+#ifdef ENTITY_INTERPOLATION_SSE
+   const U32 simdCount = count & ~3;
+   computeSSE(simdCount, dt);
+   computeScalar(simdCount, count, dt);
+#else
+   computeScalar(0, count, dt);
+#endif
+
+   //Hand the results back
+   for (U32 i = 0; i < count; i++)
+   {
+      QuatF rot(mOutRotX[i], mOutRotY[i], mOutRotZ[i], mOutRotW[i]);
+      mEntities[i]->applyInterpolatedTransform(Point3F(mOutPosX[i], mOutPosY[i], mOutPosZ[i]), rot, dt);
+   }
+}
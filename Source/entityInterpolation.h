@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_INTERPOLATION_H
+#define ENTITY_INTERPOLATION_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+class Entity;
+
+//////////////////////////////////////////////////////////////////////////
+/// Batched render transform interpolation for client entities.
+///
+/// Each ghost's interpolation state (the tick's end position, position delta and
+/// the two rotations) is mirrored here as structure-of-arrays, refreshed whenever
+/// the entity ticks or gets a transform update. Once a frame, the first entity
+/// to interpolate runs the whole batch: positions are lerped and rotations nlerped
+/// four entities at a time with SSE, or one at a time without it, and the results
+/// are handed back to each entity.
+///
+/// nlerp stands in for the per-entity slerp. Over the single tick these span, the
+/// difference isn't visible.
+//////////////////////////////////////////////////////////////////////////
+class EntityInterpolationBatch
+{
+   Vector<Entity*>   mEntities;
+
+   //Interpolation state, one entry per entity
+   Vector<F32>       mPosX, mPosY, mPosZ;
+   Vector<F32>       mVecX, mVecY, mVecZ;
+   Vector<F32>       mFromX, mFromY, mFromZ, mFromW;   ///< rot[1], where the tick started
+   Vector<F32>       mToX, mToY, mToZ, mToW;           ///< rot[0], where it's heading
+
+   //Results of the last pass
+   Vector<F32>       mOutPosX, mOutPosY, mOutPosZ;
+   Vector<F32>       mOutRotX, mOutRotY, mOutRotZ, mOutRotW;
+
+   //What the last pass ran for, so the rest of the frame's entities don't run it again
+   U32               mLastSimTime;
+   U32               mLastTickCount;
+   F32               mLastDt;
+   bool              mStateChanged;
+
+   void resize(U32 count);
+   void computeScalar(U32 start, U32 end, F32 dt);
+   void computeSSE(U32 end, F32 dt);
+
+public:
+   EntityInterpolationBatch();
+
+   static EntityInterpolationBatch* getClient();
+
+   void addEntity(Entity* entity);
+   void removeEntity(Entity* entity);
+
+   /// Copies an entity's interpolation state in, after it's changed
+   void updateEntity(Entity* entity);
+
+   /// Interpolates every entity for this frame, unless that's already been done
+   void interpolate(F32 dt);
+};
+
+#endif // ENTITY_INTERPOLATION_H
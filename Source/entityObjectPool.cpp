@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityObjectPool.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+#include "console/engineAPI.h"
+
+EntityObjectPool::SizeClass EntityObjectPool::smSizeClasses[EntityObjectPool::SizeClassCount];
+
+struct EntityPoolSlab
+{
+   U8* start;
+   U8* end;
+   U32 sizeClass;
+};
+
+//Every slab we've carved, so freeUnsized can tell which size class a block belongs to
+static Vector<EntityPoolSlab> sSlabs;
+
+void EntityObjectPool::allocSlab(U32 sizeClass)
+{
+   const U32 blockSize = (sizeClass + 1) * Granularity;
+   const U32 blockCount = SlabSize / blockSize;
+
+   //Slabs are never handed back. Once the server has seen a wave of some size, it keeps the memory for the next one
+   U8* slab = (U8*)dMalloc_aligned(blockCount * blockSize, Granularity);
+
+   EntityPoolSlab slabInfo;
+   slabInfo.start = slab;
+   slabInfo.end = slab + blockCount * blockSize;
+   slabInfo.sizeClass = sizeClass;
+   sSlabs.push_back(slabInfo);
+
+   SizeClass& sc = smSizeClasses[sizeClass];
+   for (U32 i = 0; i < blockCount; i++)
+   {
+      FreeBlock* block = (FreeBlock*)(slab + i * blockSize);
+      block->next = sc.freeList;
+      sc.freeList = block;
+   }
+
+   sc.freeCount += blockCount;
+   sc.slabCount++;
+}
+
+void* EntityObjectPool::alloc(dsize_t size)
+{
+   AssertFatal(ThreadManager::isMainThread(), "EntityObjectPool::alloc() - Entities and components must be created on the main thread.");
+
+   if (size == 0)
+      size = 1;
+
+   if (size > MaxPooledSize)
+      return dMalloc(size);
+
+   const U32 sizeClass = (size - 1) / Granularity;
+   SizeClass& sc = smSizeClasses[sizeClass];
+
+   if (sc.freeList == NULL)
+      allocSlab(sizeClass);
+
+   FreeBlock* block = sc.freeList;
+   sc.freeList = block->next;
+   sc.freeCount--;
+   sc.liveCount++;
+
+   return block;
+}
+
+void EntityObjectPool::free(void* ptr, dsize_t size)
+{
+   if (ptr == NULL)
+      return;
+
+   AssertFatal(ThreadManager::isMainThread(), "EntityObjectPool::free() - Entities and components must be deleted on the main thread.");
+
+   if (size == 0)
+      size = 1;
+
+   if (size > MaxPooledSize)
+   {
+      dFree(ptr);
+      return;
+   }
+
+   const U32 sizeClass = (size - 1) / Granularity;
+   SizeClass& sc = smSizeClasses[sizeClass];
+
+   AssertFatal(sc.liveCount > 0, "EntityObjectPool::free() - Freeing a block from a size class with nothing allocated.");
+
+   FreeBlock* block = (FreeBlock*)ptr;
+   block->next = sc.freeList;
+   sc.freeList = block;
+
+   sc.freeCount++;
+   sc.liveCount--;
+}
+
+void EntityObjectPool::freeUnsized(void* ptr)
+{
+   if (ptr == NULL)
+      return;
+
+   for (U32 i = 0; i < sSlabs.size(); i++)
+   {
+      if (ptr >= sSlabs[i].start && ptr < sSlabs[i].end)
+      {
+         free(ptr, (sSlabs[i].sizeClass + 1) * Granularity);
+         return;
+      }
+   }
+
+   //not from any slab, so it was too big to pool
+   dFree(ptr);
+}
+
+void EntityObjectPool::dumpStats()
+{
+   Con::printf("EntityObjectPool:");
+
+   U32 totalBytes = 0;
+   for (U32 i = 0; i < SizeClassCount; i++)
+   {
+      const SizeClass& sc = smSizeClasses[i];
+      if (sc.slabCount == 0)
+         continue;
+
+      const U32 blockSize = (i + 1) * Granularity;
+      Con::printf("   %5d bytes: %6d live, %6d free, %3d slabs", blockSize, sc.liveCount, sc.freeCount, sc.slabCount);
+
+      totalBytes += sc.slabCount * (SlabSize / blockSize) * blockSize;
+   }
+
+   Con::printf("   %d bytes reserved in total", totalBytes);
+}
+
+DefineEngineFunction(dumpEntityPoolStats, void, (), ,
+   "Prints how much of the entity and component allocation pool is in use, per size class.\n"
+   "@ingroup Entity\n")
+{
+   EntityObjectPool::dumpStats();
+}
@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_OBJECT_POOL_H
+#define ENTITY_OBJECT_POOL_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+/// Size-class pool backing Entity and Component allocations.
+///
+/// Requests are rounded up to a multiple of Granularity and served from a free
+/// list for that size, carved out of large slabs. Freed blocks go back on their
+/// list for the next object of that size rather than to the system heap, so
+/// spawning and despawning the same kinds of objects over and over reuses the
+/// same memory. Anything bigger than MaxPooledSize falls through to dMalloc.
+///
+/// Objects are only created and destroyed on the main thread, so the pool
+/// isn't locked.
+//////////////////////////////////////////////////////////////////////////
+class EntityObjectPool
+{
+public:
+   enum
+   {
+      Granularity = 16,
+      MaxPooledSize = 4096,
+      SizeClassCount = MaxPooledSize / Granularity,
+      SlabSize = 64 * 1024
+   };
+
+   static void* alloc(dsize_t size);
+   static void free(void* ptr, dsize_t size);
+
+   /// For when the size isn't known, which is only the placement delete a throwing constructor lands
+   /// in. Finds the size class by looking up the slab ptr came from, so it's slow
+   static void freeUnsized(void* ptr);
+
+   /// Prints live and free block counts per size class to the console
+   static void dumpStats();
+
+private:
+   struct FreeBlock
+   {
+      FreeBlock* next;
+   };
+
+   struct SizeClass
+   {
+      FreeBlock*  freeList;
+      U32         liveCount;
+      U32         freeCount;
+      U32         slabCount;
+   };
+
+   static SizeClass smSizeClasses[SizeClassCount];
+
+   static void allocSlab(U32 sizeClass);
+};
+
+/// Allocates the class, and everything derived from it, from the EntityObjectPool. Place it in the
+/// public section of the class. The file/line overloads are what the memory manager's new resolves to.
+#define DECLARE_ENTITY_POOL_ALLOCATOR()                                                                   \
+   void* operator new(size_t size) { return EntityObjectPool::alloc(size); }                             \
+   void* operator new(size_t size, const char*, const U32) { return EntityObjectPool::alloc(size); }     \
+   void operator delete(void* ptr, size_t size) { EntityObjectPool::free(ptr, size); }                   \
+   void operator delete(void* ptr, const char*, const U32) { EntityObjectPool::freeUnsized(ptr); }
+
+#endif // ENTITY_OBJECT_POOL_H
@@ -0,0 +1,306 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityPrototype.h"
+#include "entity.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "console/simFieldDictionary.h"
+#include "persistence/taml/taml.h"
+
+IMPLEMENT_CONOBJECT(EntityPrototype);
+
+ConsoleDocClass(EntityPrototype,
+   "@brief Builds an entity template once and spawns copies of it in bulk.\n\n"
+   "@ingroup Entity\n");
+
+EntityPrototype::EntityPrototype()
+{
+   mEntityTemplate.classRep = NULL;
+   mTemplateValid = false;
+}
+
+EntityPrototype::~EntityPrototype()
+{
+}
+
+void EntityPrototype::initPersistFields()
+{
+   addField("GameObject", TypeGameObjectAssetPtr, Offset(mGameObjectAsset, EntityPrototype), "The GameObject asset the template is built from.");
+
+   Parent::initPersistFields();
+}
+
+void EntityPrototype::onStaticModified(const char* slotName, const char* newValue)
+{
+   Parent::onStaticModified(slotName, newValue);
+
+   if (!dStricmp(slotName, "GameObject"))
+      clearTemplate();
+}
+
+//////////////////////////////////////////////////////////////////////////
+void EntityPrototype::captureObject(SimObject* source, ObjectTemplate& outTemplate)
+{
+   outTemplate.classRep = source->getClassRep();
+   outTemplate.fields.clear();
+
+   //Only keep what differs from a freshly constructed object, so spawning sets as few fields as possible
+   SimObject* defaults = dynamic_cast<SimObject*>(outTemplate.classRep->create());
+
+   const AbstractClassRep::FieldList& fieldList = outTemplate.classRep->mFieldList;
+   for (U32 i = 0; i < fieldList.size(); i++)
+   {
+      const AbstractClassRep::Field& field = fieldList[i];
+
+      if (field.type >= AbstractClassRep::ARCFirstCustomField)
+         continue;
+
+      //Identity and hierarchy belong to the clone, not the template
+      if (!dStricmp(field.pFieldname, "name") || !dStricmp(field.pFieldname, "parentGroup") ||
+         !dStricmp(field.pFieldname, "persistentId") || !dStricmp(field.pFieldname, "owner"))
+         continue;
+
+      for (U32 j = 0; j < field.elementCount; j++)
+      {
+         char arrayIndex[8];
+         dSprintf(arrayIndex, sizeof(arrayIndex), "%d", j);
+         const char* array = field.elementCount > 1 ? arrayIndex : NULL;
+
+         //getDataField may hand back a shared buffer, so copy before fetching the default
+         String value = source->getDataField(field.pFieldname, array);
+
+         if (defaults && value.equal(defaults->getDataField(field.pFieldname, array)))
+            continue;
+
+         FieldValue fieldValue;
+         fieldValue.slotName = field.pFieldname;
+         fieldValue.array = array ? StringTable->insert(array) : NULL;
+         fieldValue.value = value;
+
+         outTemplate.fields.push_back(fieldValue);
+      }
+   }
+
+   delete defaults;
+
+   SimFieldDictionary* dynamicFields = source->getFieldDictionary();
+   if (dynamicFields)
+   {
+      for (SimFieldDictionaryIterator itr(dynamicFields); *itr; ++itr)
+      {
+         SimFieldDictionary::Entry* entry = *itr;
+
+         FieldValue fieldValue;
+         fieldValue.slotName = entry->slotName;
+         fieldValue.array = NULL;
+         fieldValue.value = entry->value;
+
+         outTemplate.fields.push_back(fieldValue);
+      }
+   }
+}
+
+void EntityPrototype::applyFields(SimObject* target, const ObjectTemplate& objTemplate)
+{
+   for (U32 i = 0; i < objTemplate.fields.size(); i++)
+   {
+      const FieldValue& field = objTemplate.fields[i];
+      target->setDataField(field.slotName, field.array, field.value.c_str());
+   }
+}
+
+bool EntityPrototype::setTemplate(Entity* source)
+{
+   clearTemplate();
+
+   if (source == NULL)
+      return false;
+
+   captureObject(source, mEntityTemplate);
+
+   mComponentTemplates.setSize(source->getComponentCount());
+   for (U32 i = 0; i < source->getComponentCount(); i++)
+      captureObject(source->getComponent(i), mComponentTemplates[i]);
+
+   mTemplateValid = true;
+
+   return true;
+}
+
+void EntityPrototype::clearTemplate()
+{
+   mEntityTemplate.classRep = NULL;
+   mEntityTemplate.fields.clear();
+   mComponentTemplates.clear();
+
+   mTemplateValid = false;
+}
+
+bool EntityPrototype::buildFromAsset()
+{
+   if (mGameObjectAsset.isNull())
+      return false;
+
+   const char* tamlFile = mGameObjectAsset->getTAMLFile();
+   if (tamlFile == NULL || !Platform::isFile(tamlFile))
+   {
+      Con::errorf("EntityPrototype::buildFromAsset() - GameObject asset has no TAML file to build from.");
+      return false;
+   }
+
+   //Construct the game object the usual way once, capture it, then throw it away
+   Taml taml;
+   Entity* source = dynamic_cast<Entity*>(taml.read(tamlFile));
+
+   if (source == NULL)
+   {
+      Con::errorf("EntityPrototype::buildFromAsset() - GameObject asset %s did not produce an Entity.", mGameObjectAsset.getAssetId());
+      return false;
+   }
+
+   bool result = setTemplate(source);
+
+   source->deleteObject();
+
+   return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+U32 EntityPrototype::spawn(U32 count, SimGroup* group, const MatrixF* transforms, Vector<Entity*>* outEntities)
+{
+   PROFILE_SCOPE(EntityPrototype_Spawn);
+
+   if (!mTemplateValid && !buildFromAsset())
+      return 0;
+
+   if (group == NULL)
+      Sim::findObject("MissionCleanup", group);
+
+   if (outEntities)
+      outEntities->reserve(outEntities->size() + count);
+
+   const U32 componentCount = mComponentTemplates.size();
+
+   Vector<Component*> components;
+   components.reserve(componentCount);
+
+   U32 spawned = 0;
+   for (U32 i = 0; i < count; i++)
+   {
+      Entity* entity = static_cast<Entity*>(mEntityTemplate.classRep->create());
+      applyFields(entity, mEntityTemplate);
+
+      if (transforms)
+         entity->setTransform(transforms[i]);
+
+      components.clear();
+      for (U32 c = 0; c < componentCount; c++)
+      {
+         Component* comp = static_cast<Component*>(mComponentTemplates[c].classRep->create());
+         applyFields(comp, mComponentTemplates[c]);
+
+         if (!comp->registerObject())
+         {
+            delete comp;
+            continue;
+         }
+
+         components.push_back(comp);
+      }
+
+      entity->addComponents(components);
+
+      if (!entity->registerObject())
+      {
+         entity->clearComponents(false);
+         delete entity;
+
+         for (U32 c = 0; c < components.size(); c++)
+            components[c]->deleteObject();
+
+         continue;
+      }
+
+      //this is where script construction would finish the object, doing component init and network setup in one go
+      entity->onPostAdd();
+
+      if (group)
+         group->addObject(entity);
+
+      if (outEntities)
+         outEntities->push_back(entity);
+
+      spawned++;
+   }
+
+   return spawned;
+}
+
+//////////////////////////////////////////////////////////////////////////
+DefineEngineMethod(EntityPrototype, setTemplate, bool, (Entity* source), (nullAsType<Entity*>()),
+   "Captures an existing entity and its components as the template to spawn from.\n"
+   "@param source The entity to copy. It is left untouched.\n"
+   "@return True if the template was captured.")
+{
+   return object->setTemplate(source);
+}
+
+DefineEngineMethod(EntityPrototype, clearTemplate, void, (), ,
+   "Throws away the current template so it's rebuilt from the GameObject asset on the next spawn.\n")
+{
+   object->clearTemplate();
+}
+
+DefineEngineMethod(EntityPrototype, spawn, const char*, (U32 count, SimGroup* group, TransformF transform), (1, nullAsType<SimGroup*>(), TransformF::Identity),
+   "Spawns a number of entities from the template.\n"
+   "@param count How many entities to spawn.\n"
+   "@param group The group to put them in. Defaults to MissionCleanup.\n"
+   "@param transform Where to place them. If left as the identity, the template's transform is used.\n"
+   "@return A space-separated list of the spawned entities' ids.")
+{
+   Vector<MatrixF> transforms;
+   if (!transform.getMatrix().isIdentity())
+   {
+      transforms.setSize(count);
+      for (U32 i = 0; i < count; i++)
+         transforms[i] = transform.getMatrix();
+   }
+
+   Vector<Entity*> entities;
+   object->spawn(count, group, transforms.empty() ? NULL : transforms.address(), &entities);
+
+   if (entities.empty())
+      return "";
+
+   const U32 bufSize = entities.size() * 12;
+   char* returnBuffer = Con::getReturnBuffer(bufSize);
+   returnBuffer[0] = '\0';
+
+   U32 len = 0;
+   for (U32 i = 0; i < entities.size(); i++)
+      len += dSprintf(returnBuffer + len, bufSize - len, i == 0 ? "%d" : " %d", entities[i]->getId());
+
+   return returnBuffer;
+}
@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_PROTOTYPE_H
+#define ENTITY_PROTOTYPE_H
+
+#ifndef _SIMOBJECT_H_
+#include "console/simObject.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _ASSET_PTR_H_
+#include "assets/assetPtr.h"
+#endif
+#ifndef GAME_OBJECT_ASSET_H
+#include "T3D/assets/GameObjectAsset.h"
+#endif
+
+class Entity;
+class SimGroup;
+class MatrixF;
+
+//////////////////////////////////////////////////////////////////////////
+/// Spawns entities in bulk from a template.
+///
+/// The template is built once, from a GameObject asset or an existing entity, and
+/// boiled down to the class of the entity and each of its components plus whatever
+/// fields differ from the class defaults. Spawning then just creates the objects and
+/// applies those fields, with no TAML or script construction, and the components are
+/// attached in a single pass instead of one addComponent at a time.
+//////////////////////////////////////////////////////////////////////////
+class EntityPrototype : public SimObject
+{
+   typedef SimObject Parent;
+
+   struct FieldValue
+   {
+      StringTableEntry  slotName;
+      StringTableEntry  array;
+      String            value;
+   };
+
+   struct ObjectTemplate
+   {
+      AbstractClassRep*    classRep;
+      Vector<FieldValue>   fields;
+   };
+
+   ObjectTemplate             mEntityTemplate;
+   Vector<ObjectTemplate>     mComponentTemplates;
+
+   bool                       mTemplateValid;
+
+   AssetPtr<GameObjectAsset>  mGameObjectAsset;
+
+   static void captureObject(SimObject* source, ObjectTemplate& outTemplate);
+   static void applyFields(SimObject* target, const ObjectTemplate& objTemplate);
+
+   bool buildFromAsset();
+
+public:
+   EntityPrototype();
+   virtual ~EntityPrototype();
+
+   static void initPersistFields();
+
+   virtual void onStaticModified(const char* slotName, const char* newValue = NULL);
+
+   /// Captures the entity and its components as our template. The entity is left untouched.
+   bool setTemplate(Entity* source);
+
+   /// Throws away the current template so it's rebuilt from the asset on the next spawn
+   void clearTemplate();
+
+   bool isTemplateValid() const { return mTemplateValid; }
+
+   /// Spawns count entities into group, or MissionCleanup if no group is given. If transforms is
+   /// provided it must hold count entries. Returns the number of entities actually spawned.
+   U32 spawn(U32 count, SimGroup* group = NULL, const MatrixF* transforms = NULL, Vector<Entity*>* outEntities = NULL);
+
+   DECLARE_CONOBJECT(EntityPrototype);
+};
+
+#endif // ENTITY_PROTOTYPE_H
@@ -0,0 +1,256 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityQuery.h"
+#include "entity.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "core/strings/stringUnit.h"
+
+namespace
+{
+   //Every active query, and every server entity we could be asked to match against
+   Vector<EntityQuery*>& getActiveQueries()
+   {
+      static Vector<EntityQuery*> sActiveQueries;
+      return sActiveQueries;
+   }
+
+   Vector<Entity*>& getTrackedEntities()
+   {
+      static Vector<Entity*> sTrackedEntities;
+      return sTrackedEntities;
+   }
+}
+
+IMPLEMENT_CONOBJECT(EntityQuery);
+
+ConsoleDocClass(EntityQuery,
+   "@brief A live list of every server entity that has all of a set of component types.\n\n"
+   "@ingroup Entity\n");
+
+EntityQuery::EntityQuery()
+{
+   mRequiredTypes = 0;
+   mActive = false;
+}
+
+EntityQuery::~EntityQuery()
+{
+   deactivate();
+}
+
+void EntityQuery::initPersistFields()
+{
+   addProtectedField("componentTypes", TypeRealString, Offset(mComponentTypes, EntityQuery), &_setComponentTypes, &defaultProtectedGetFn,
+      "Space separated list of component classes an entity must have to be part of the results.");
+
+   Parent::initPersistFields();
+}
+
+void EntityQuery::onRemove()
+{
+   deactivate();
+
+   Parent::onRemove();
+}
+
+bool EntityQuery::_setComponentTypes(void *object, const char *index, const char *data)
+{
+   EntityQuery* query = static_cast<EntityQuery*>(object);
+   if (query)
+      query->setComponentTypes(data);
+
+   return false;
+}
+
+bool EntityQuery::setComponentTypes(const char* classNames)
+{
+   mComponentTypes = classNames ? classNames : "";
+
+   ComponentTypeMask typeMask = 0;
+   bool result = true;
+
+   const U32 nameCount = StringUnit::getUnitCount(mComponentTypes, " \t\n");
+   for (U32 i = 0; i < nameCount; i++)
+   {
+      const char* className = StringUnit::getUnit(mComponentTypes, i, " \t\n");
+
+      AbstractClassRep* classRep = AbstractClassRep::findClassRep(className);
+      if (classRep == NULL || !classRep->isSubclassOf("Component"))
+      {
+         Con::errorf("EntityQuery::setComponentTypes() - %s is not a component class.", className);
+         result = false;
+         continue;
+      }
+
+      //Classes only get a type id once they're first used, so make sure this one has one
+      typeMask |= ComponentTypeRegistry::getTypeBit(ComponentTypeRegistry::registerType(classRep->getClassName()));
+   }
+
+   setRequiredTypes(typeMask);
+
+   return result;
+}
+
+void EntityQuery::setRequiredTypes(ComponentTypeMask typeMask)
+{
+   if (mActive && typeMask == mRequiredTypes)
+      return;
+
+   deactivate();
+
+   mRequiredTypes = typeMask;
+
+   if (mRequiredTypes != 0)
+      activate();
+}
+
+void EntityQuery::activate()
+{
+   if (mActive)
+      return;
+
+   //Only time we look at everything; from here on the entities tell us when they change
+   const Vector<Entity*>& entities = getTrackedEntities();
+   for (U32 i = 0; i < entities.size(); i++)
+   {
+      if (matches(entities[i]->getComponentTypeMask()))
+         addEntity(entities[i]);
+   }
+
+   getActiveQueries().push_back(this);
+   mActive = true;
+}
+
+void EntityQuery::deactivate()
+{
+   if (!mActive)
+      return;
+
+   getActiveQueries().remove(this);
+   mActive = false;
+
+   mEntities.clear();
+   mEntityIndices.clear();
+}
+
+void EntityQuery::addEntity(Entity* entity)
+{
+   mEntityIndices.insertUnique(entity, mEntities.size());
+   mEntities.push_back(entity);
+}
+
+void EntityQuery::removeEntity(Entity* entity)
+{
+   HashTable<const void*, U32>::Iterator itr = mEntityIndices.find(entity);
+   if (itr == mEntityIndices.end())
+      return;
+
+   const U32 index = itr->value;
+   mEntityIndices.erase(itr);
+
+   Entity* moved = mEntities.last();
+   mEntities[index] = moved;
+   mEntities.pop_back();
+
+   if (moved != entity)
+      mEntityIndices.find(moved)->value = index;
+}
+
+void EntityQuery::trackEntity(Entity* entity)
+{
+   if (entity->mQueryIndex != -1)
+      return;
+
+   entity->mQueryIndex = getTrackedEntities().size();
+   getTrackedEntities().push_back(entity);
+
+   onEntityTypesChanged(entity, 0, entity->getComponentTypeMask());
+}
+
+void EntityQuery::untrackEntity(Entity* entity)
+{
+   if (entity->mQueryIndex == -1)
+      return;
+
+   onEntityTypesChanged(entity, entity->getComponentTypeMask(), 0);
+
+   Vector<Entity*>& entities = getTrackedEntities();
+   const U32 index = entity->mQueryIndex;
+
+   Entity* moved = entities.last();
+   entities[index] = moved;
+   entities.pop_back();
+
+   moved->mQueryIndex = index;
+   entity->mQueryIndex = -1;
+}
+
+void EntityQuery::onEntityTypesChanged(Entity* entity, ComponentTypeMask oldTypes, ComponentTypeMask newTypes)
+{
+   if (entity->mQueryIndex == -1 || oldTypes == newTypes)
+      return;
+
+   Vector<EntityQuery*>& queries = getActiveQueries();
+   for (U32 i = 0; i < queries.size(); i++)
+   {
+      EntityQuery* query = queries[i];
+
+      const bool wasMatch = query->matches(oldTypes);
+      const bool isMatch = query->matches(newTypes);
+
+      if (isMatch && !wasMatch)
+         query->addEntity(entity);
+      else if (wasMatch && !isMatch)
+         query->removeEntity(entity);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+DefineEngineMethod(EntityQuery, getCount, S32, (), ,
+   "Get the number of entities currently matching the query.\n"
+   "@return The number of matching entities.")
+{
+   return object->getCount();
+}
+
+DefineEngineMethod(EntityQuery, getEntity, S32, (U32 index), (0),
+   "Get one of the matching entities.\n"
+   "@param index Index of the entity, from 0 to getCount() - 1.\n"
+   "@return The entity's id, or 0 if the index is out of range.")
+{
+   if (index >= object->getCount())
+      return 0;
+
+   return object->getEntity(index)->getId();
+}
+
+DefineEngineMethod(EntityQuery, contains, bool, (Entity* entity), (nullAsType<Entity*>()),
+   "Checks if an entity currently matches the query.\n"
+   "@param entity The entity to check.\n"
+   "@return True if the entity is in the results.")
+{
+   return entity != nullptr && object->contains(entity);
+}
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_QUERY_H
+#define ENTITY_QUERY_H
+
+#ifndef _SIMOBJECT_H_
+#include "console/simObject.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+#ifndef COMPONENT_TYPE_REGISTRY_H
+#include "components/componentTypeRegistry.h"
+#endif
+
+class Entity;
+
+//////////////////////////////////////////////////////////////////////////
+/// A live list of every server entity that has all of a set of component types.
+///
+/// Membership is kept up to date as entities are added and removed and as their
+/// components change, so reading the results is just walking a vector. A type
+/// matches its subclasses too, so asking for PhysicsComponent finds entities with
+/// a RigidBodyComponent.
+///
+/// From C++:
+/// @code
+///    EntityQuery query;
+///    query.requireType<RigidBodyComponent>();
+///    query.requireType<ShapeCollisionComponent>();
+///
+///    for (U32 i = 0; i < query.getCount(); i++)
+///       query.getEntity(i)->...
+/// @endcode
+///
+/// Deleting entities while walking the results reorders them, so walk backwards
+/// if that can happen.
+//////////////////////////////////////////////////////////////////////////
+class EntityQuery : public SimObject
+{
+   typedef SimObject Parent;
+
+   ComponentTypeMask             mRequiredTypes;
+   String                        mComponentTypes;
+
+   Vector<Entity*>               mEntities;
+   HashTable<const void*, U32>   mEntityIndices;
+
+   bool                          mActive;
+
+   void activate();
+   void deactivate();
+
+   void addEntity(Entity* entity);
+   void removeEntity(Entity* entity);
+
+   bool matches(ComponentTypeMask typeMask) const
+   {
+      return mRequiredTypes != 0 && (typeMask & mRequiredTypes) == mRequiredTypes;
+   }
+
+   static bool _setComponentTypes(void *object, const char *index, const char *data);
+
+public:
+   EntityQuery();
+   virtual ~EntityQuery();
+
+   static void initPersistFields();
+
+   virtual void onRemove();
+
+   /// Sets the required types from a list of component class names
+   /// @return False if any of the names isn't a component class
+   bool setComponentTypes(const char* classNames);
+
+   void setRequiredTypes(ComponentTypeMask typeMask);
+   ComponentTypeMask getRequiredTypes() const { return mRequiredTypes; }
+
+   template <class T>
+   void requireType()
+   {
+      setRequiredTypes(mRequiredTypes | ComponentTypeRegistry::getTypeBit(T::getStaticComponentTypeId()));
+   }
+
+   U32 getCount() const { return mEntities.size(); }
+   Entity* getEntity(U32 index) const { return mEntities[index]; }
+   const Vector<Entity*>& getEntities() const { return mEntities; }
+
+   bool contains(Entity* entity) const { return mEntityIndices.find(entity) != mEntityIndices.end(); }
+
+   /// Entities are tracked while they're added on the server, and tell us whenever their component types change
+   static void trackEntity(Entity* entity);
+   static void untrackEntity(Entity* entity);
+   static void onEntityTypesChanged(Entity* entity, ComponentTypeMask oldTypes, ComponentTypeMask newTypes);
+
+   DECLARE_CONOBJECT(EntityQuery);
+};
+
+#endif // ENTITY_QUERY_H
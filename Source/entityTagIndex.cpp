@@ -0,0 +1,186 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityTagIndex.h"
+#include "entity.h"
+#include "core/util/tDictionary.h"
+
+namespace
+{
+   struct TagEntry
+   {
+      StringTableEntry  name;
+      Vector<Entity*>   entities;
+   };
+
+   //Entries are held by pointer so the entity lists don't move when a new tag is registered
+   Vector<TagEntry*>& getTagEntries()
+   {
+      static Vector<TagEntry*> sTagEntries;
+      return sTagEntries;
+   }
+
+   HashTable<const void*, U32>& getTagIds()
+   {
+      static HashTable<const void*, U32> sTagIds;
+      return sTagIds;
+   }
+}
+
+U32 EntityTagIndex::findTagId(const char* tagName)
+{
+   //The string table is case insensitive, so "Enemy" and "enemy" are the same tag
+   StringTableEntry name = StringTable->lookup(tagName);
+   if (name == NULL)
+      return InvalidTagId;
+
+   HashTable<const void*, U32>::Iterator itr = getTagIds().find(name);
+   if (itr == getTagIds().end())
+      return InvalidTagId;
+
+   return itr->value;
+}
+
+U32 EntityTagIndex::getTagId(const char* tagName)
+{
+   U32 tagId = findTagId(tagName);
+   if (tagId != InvalidTagId)
+      return tagId;
+
+   TagEntry* entry = new TagEntry();
+   entry->name = StringTable->insert(tagName);
+
+   tagId = getTagEntries().size();
+   getTagEntries().push_back(entry);
+   getTagIds().insertUnique(entry->name, tagId);
+
+   return tagId;
+}
+
+StringTableEntry EntityTagIndex::getTagName(U32 tagId)
+{
+   if (tagId >= getTagEntries().size())
+      return StringTable->EmptyString();
+
+   return getTagEntries()[tagId]->name;
+}
+
+const Vector<Entity*>& EntityTagIndex::getEntities(U32 tagId)
+{
+   static const Vector<Entity*> sNoEntities;
+
+   if (tagId >= getTagEntries().size())
+      return sNoEntities;
+
+   return getTagEntries()[tagId]->entities;
+}
+
+U32 EntityTagIndex::findEntities(const U32* tagIds, U32 tagCount, Vector<Entity*>& outEntities)
+{
+   if (tagCount == 0)
+      return 0;
+
+   //Walk the rarest tag and filter by the rest
+   U32 smallest = 0;
+   for (U32 i = 0; i < tagCount; i++)
+   {
+      if (tagIds[i] >= getTagEntries().size())
+         return 0;
+
+      if (getEntities(tagIds[i]).size() < getEntities(tagIds[smallest]).size())
+         smallest = i;
+   }
+
+   const Vector<Entity*>& candidates = getEntities(tagIds[smallest]);
+
+   U32 found = 0;
+   for (U32 i = 0; i < candidates.size(); i++)
+   {
+      Entity* entity = candidates[i];
+
+      bool match = true;
+      for (U32 t = 0; t < tagCount && match; t++)
+      {
+         if (t != smallest)
+            match = entity->hasTag(tagIds[t]);
+      }
+
+      if (match)
+      {
+         outEntities.push_back(entity);
+         found++;
+      }
+   }
+
+   return found;
+}
+
+void EntityTagIndex::addEntity(Entity* entity, U32 tagId)
+{
+   AssertFatal(tagId < getTagEntries().size(), "EntityTagIndex::addEntity() - Invalid tag id.");
+
+   Vector<Entity*>& entities = getTagEntries()[tagId]->entities;
+
+   Entity::TagSlot slot;
+   slot.tagId = tagId;
+   slot.index = entities.size();
+   entity->mTagSlots.push_back(slot);
+
+   entities.push_back(entity);
+}
+
+void EntityTagIndex::removeEntity(Entity* entity, U32 tagId)
+{
+   AssertFatal(tagId < getTagEntries().size(), "EntityTagIndex::removeEntity() - Invalid tag id.");
+
+   Vector<Entity*>& entities = getTagEntries()[tagId]->entities;
+
+   for (U32 i = 0; i < entity->mTagSlots.size(); i++)
+   {
+      if (entity->mTagSlots[i].tagId != tagId)
+         continue;
+
+      const U32 index = entity->mTagSlots[i].index;
+      entity->mTagSlots.erase_fast(i);
+
+      //Swap the last entity into the hole and fix up its slot
+      Entity* moved = entities.last();
+      entities[index] = moved;
+      entities.pop_back();
+
+      if (moved != entity)
+      {
+         for (U32 s = 0; s < moved->mTagSlots.size(); s++)
+         {
+            if (moved->mTagSlots[s].tagId == tagId)
+            {
+               moved->mTagSlots[s].index = index;
+               break;
+            }
+         }
+      }
+
+      return;
+   }
+}
@@ -0,0 +1,75 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_TAG_INDEX_H
+#define ENTITY_TAG_INDEX_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _STRINGTABLE_H_
+#include "core/stringTable.h"
+#endif
+
+class Entity;
+
+//////////////////////////////////////////////////////////////////////////
+/// Global tag registry and inverted index from tag to the entities carrying it.
+///
+/// Tag names are interned to dense ids. Each entity keeps a bitset of its tag ids,
+/// and each tag keeps a list of its entities, so an AND query walks the smallest
+/// of the lists and checks the rest against each candidate's bits.
+///
+/// Only server entities are indexed.
+//////////////////////////////////////////////////////////////////////////
+class EntityTagIndex
+{
+public:
+   enum
+   {
+      InvalidTagId = 0xFFFFFFFF
+   };
+
+   /// Returns the id for a tag, registering it if need be
+   static U32 getTagId(const char* tagName);
+
+   /// Returns the id for a tag, or InvalidTagId if no entity has ever used it
+   static U32 findTagId(const char* tagName);
+
+   static StringTableEntry getTagName(U32 tagId);
+
+   /// The entities currently carrying a tag
+   static const Vector<Entity*>& getEntities(U32 tagId);
+
+   /// Appends every entity carrying all of the given tags to outEntities
+   /// @return The number of entities found
+   static U32 findEntities(const U32* tagIds, U32 tagCount, Vector<Entity*>& outEntities);
+
+   static void addEntity(Entity* entity, U32 tagId);
+   static void removeEntity(Entity* entity, U32 tagId);
+};
+
+#endif // ENTITY_TAG_INDEX_H
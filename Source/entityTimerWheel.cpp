@@ -0,0 +1,230 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "entityTimerWheel.h"
+#include "entity.h"
+#include "T3D/gameBase/gameProcess.h"
+#include "platform/profiler.h"
+
+EntityTimerWheel::EntityTimerWheel(bool isServer)
+{
+   mIsServer = isServer;
+   mHooked = false;
+   mCurrentTick = 0;
+
+   for (U32 level = 0; level < LevelCount; level++)
+   {
+      for (U32 slot = 0; slot < SlotCount; slot++)
+      {
+         Timer& sentinel = mSlots[level][slot];
+         sentinel.entity = NULL;
+         sentinel.next = sentinel.prev = &sentinel;
+      }
+   }
+}
+
+EntityTimerWheel::~EntityTimerWheel()
+{
+   if (mHooked)
+      getProcessList()->postTickSignal().remove(this, &EntityTimerWheel::onPostTick);
+}
+
+EntityTimerWheel* EntityTimerWheel::getServer()
+{
+   static EntityTimerWheel sServerWheel(true);
+   return &sServerWheel;
+}
+
+EntityTimerWheel* EntityTimerWheel::getClient()
+{
+   static EntityTimerWheel sClientWheel(false);
+   return &sClientWheel;
+}
+
+ProcessList* EntityTimerWheel::getProcessList() const
+{
+   if (mIsServer)
+      return ServerProcessList::get();
+
+   return ClientProcessList::get();
+}
+
+void EntityTimerWheel::hook()
+{
+   if (mHooked)
+      return;
+
+   //start counting from wherever the process list is up to
+   mCurrentTick = getProcessList()->getTotalTicks();
+   getProcessList()->postTickSignal().notify(this, &EntityTimerWheel::onPostTick);
+   mHooked = true;
+}
+
+U32 EntityTimerWheel::getCurrentTick()
+{
+   hook();
+   return mCurrentTick;
+}
+
+//////////////////////////////////////////////////////////////////////////
+EntityTimerWheel::Timer* EntityTimerWheel::schedule(Entity* ent, U32 delayTicks)
+{
+   hook();
+
+   Timer* timer = mTimerChunker.alloc();
+   timer->entity = ent;
+   timer->entityId = ent->getId();
+   timer->expireTick = mCurrentTick + getMax(delayTicks, (U32)1);
+
+   insert(timer);
+
+   return timer;
+}
+
+void EntityTimerWheel::cancel(Timer* timer)
+{
+   if (timer == NULL)
+      return;
+
+   unlink(timer);
+   mTimerChunker.free(timer);
+}
+
+void EntityTimerWheel::unlink(Timer* timer)
+{
+   timer->prev->next = timer->next;
+   timer->next->prev = timer->prev;
+   timer->next = timer->prev = timer;
+}
+
+void EntityTimerWheel::insert(Timer* timer)
+{
+   U32 level = 0;
+   U32 slot = mCurrentTick & SlotMask;
+
+   //anything already due goes in the slot we're about to process
+   if (timer->expireTick > mCurrentTick)
+   {
+      const U32 delta = timer->expireTick - mCurrentTick;
+
+      //find the lowest level whose range covers the delay. Anything past the top level gets parked in the
+      //top level and will just cascade back up into it until it's in range
+      U32 expire = timer->expireTick;
+      while (level < LevelCount - 1 && delta >= (U32(1) << (SlotBits * (level + 1))))
+         level++;
+
+      if (level == LevelCount - 1 && delta >= (U32(1) << (SlotBits * LevelCount)))
+         expire = mCurrentTick + (U32(1) << (SlotBits * LevelCount)) - 1;
+
+      slot = (expire >> (SlotBits * level)) & SlotMask;
+   }
+
+   Timer& sentinel = mSlots[level][slot];
+   timer->prev = sentinel.prev;
+   timer->next = &sentinel;
+   sentinel.prev->next = timer;
+   sentinel.prev = timer;
+}
+
+void EntityTimerWheel::cascade(U32 level)
+{
+   const U32 slot = (mCurrentTick >> (SlotBits * level)) & SlotMask;
+   Timer& sentinel = mSlots[level][slot];
+
+   //detach the whole list first, as timers can land back in this same slot
+   Timer* timer = sentinel.next;
+   sentinel.next->prev = NULL;
+   sentinel.prev->next = NULL;
+   sentinel.next = sentinel.prev = &sentinel;
+
+   while (timer != NULL && timer != &sentinel)
+   {
+      Timer* next = timer->next;
+      insert(timer);
+      timer = next;
+   }
+
+   //every time this level wraps around, the next level up is due to cascade too
+   if (slot == 0 && level + 1 < LevelCount)
+      cascade(level + 1);
+}
+
+void EntityTimerWheel::advanceTo(U32 targetTick)
+{
+   while (mCurrentTick != targetTick)
+   {
+      mCurrentTick++;
+
+      const U32 slot = mCurrentTick & SlotMask;
+      if (slot == 0)
+         cascade(1);
+
+      Timer& sentinel = mSlots[0][slot];
+      while (sentinel.next != &sentinel)
+      {
+         Timer* timer = sentinel.next;
+         unlink(timer);
+
+         mExpired.push_back(timer);
+      }
+   }
+}
+
+void EntityTimerWheel::onPostTick(SimTime elapsedTime)
+{
+   PROFILE_SCOPE(EntityTimerWheel_onPostTick);
+
+   advanceTo(getProcessList()->getTotalTicks());
+
+   if (mExpired.empty())
+      return;
+
+   //grab the entities first, and release the timers so deletion doesn't try to cancel them
+   Vector<SimObjectId> expiredIds;
+   Vector<Entity*> expiredEntities;
+   expiredIds.reserve(mExpired.size());
+   expiredEntities.reserve(mExpired.size());
+
+   for (U32 i = 0; i < mExpired.size(); i++)
+   {
+      Timer* timer = mExpired[i];
+
+      timer->entity->mLifetimeTimer = NULL;
+
+      expiredIds.push_back(timer->entityId);
+      expiredEntities.push_back(timer->entity);
+
+      mTimerChunker.free(timer);
+   }
+
+   mExpired.clear();
+
+   for (U32 i = 0; i < expiredIds.size(); i++)
+   {
+      //deleting one entity may well have taken others with it
+      SimObject* obj = Sim::findObject(expiredIds[i]);
+      if (obj == expiredEntities[i])
+         expiredEntities[i]->deleteObject();
+   }
+}
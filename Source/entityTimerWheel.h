@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef ENTITY_TIMER_WHEEL_H
+#define ENTITY_TIMER_WHEEL_H
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _DATACHUNKER_H_
+#include "core/dataChunker.h"
+#endif
+#ifndef _SIMOBJECT_H_
+#include "console/simObject.h"
+#endif
+
+class Entity;
+class ProcessList;
+
+//////////////////////////////////////////////////////////////////////////
+/// Hierarchical timer wheel for entity expiry, counted in process list ticks.
+///
+/// Entities are scheduled once when their lifetime starts rather than polling
+/// the clock every tick. Each level has 64 slots, and every level's slot spans
+/// the whole of the level below it. Timers cascade down a level as the wheel
+/// turns, so advancing one tick only touches one level 0 slot, plus a cascade
+/// every 64 ticks.
+///
+/// The wheel is advanced from the process list's post tick signal, so expired
+/// entities are all deleted together once the tick pass is over rather than
+/// from the middle of it.
+//////////////////////////////////////////////////////////////////////////
+class EntityTimerWheel
+{
+public:
+   enum
+   {
+      SlotBits = 6,
+      SlotCount = 1 << SlotBits,
+      SlotMask = SlotCount - 1,
+      LevelCount = 4
+   };
+
+   struct Timer
+   {
+      Entity* entity;
+      SimObjectId entityId;
+      U32 expireTick;
+
+      Timer* next;
+      Timer* prev;
+   };
+
+   static EntityTimerWheel* getServer();
+   static EntityTimerWheel* getClient();
+
+   /// Schedules ent for deletion delayTicks ticks from now. Returns a handle that
+   /// has to be cancelled if the entity goes away early.
+   Timer* schedule(Entity* ent, U32 delayTicks);
+   void cancel(Timer* timer);
+
+   U32 getCurrentTick();
+
+private:
+   EntityTimerWheel(bool isServer);
+   ~EntityTimerWheel();
+
+   ProcessList* getProcessList() const;
+   void hook();
+
+   void insert(Timer* timer);
+   void cascade(U32 level);
+   void advanceTo(U32 targetTick);
+
+   void onPostTick(SimTime elapsedTime);
+
+   static void unlink(Timer* timer);
+
+   bool mIsServer;
+   bool mHooked;
+
+   U32 mCurrentTick;
+
+   //circular lists with the slot itself as the sentinel node
+   Timer mSlots[LevelCount][SlotCount];
+
+   FreeListChunker<Timer> mTimerChunker;
+
+   Vector<Timer*> mExpired;
+};
+
+#endif // ENTITY_TIMER_WHEEL_H